@@ -402,7 +402,7 @@ void Application::initialize() {
 #endif
 
     check(gerium_renderer_create(
-        _application, GERIUM_FEATURE_BINDLESS_BIT, GERIUM_VERSION_ENCODE(1, 0, 0), debug, &_renderer));
+        _application, GERIUM_FEATURE_BINDLESS_BIT, GERIUM_VERSION_ENCODE(1, 0, 0), debug, nullptr, &_renderer));
     gerium_renderer_set_profiler_enable(_renderer, true);
 
     _bindlessSupported = gerium_renderer_get_enabled_features(_renderer) & GERIUM_FEATURE_BINDLESS_BIT;
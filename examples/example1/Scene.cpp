@@ -134,10 +134,15 @@ void Scene::culling() {
     _visibleMeshes.clear();
     _visibleLights.clear();
 
-    std::function<void(const BVHNode*)> cullingMesh;
-    cullingMesh = [this, camera, &cullingMesh](const BVHNode* node) {
+    // The tree is walked with an explicit stack that keeps its capacity, so culling does not allocate per frame
+    _cullingStack.clear();
+    _cullingStack.push_back(_bvh);
+    while (!_cullingStack.empty()) {
+        const auto node = _cullingStack.back();
+        _cullingStack.pop_back();
+
         if (camera->test(node->bbox()) == Intersection::None) {
-            return;
+            continue;
         }
         if (node->leaf()) {
             for (auto& obj : node->objects()) {
@@ -153,15 +158,13 @@ void Scene::culling() {
                 }
             }
         }
-        if (node->left()) {
-            cullingMesh(node->left());
-        }
         if (node->right()) {
-            cullingMesh(node->right());
+            _cullingStack.push_back(node->right());
         }
-    };
-
-    cullingMesh(_bvh);
+        if (node->left()) {
+            _cullingStack.push_back(node->left());
+        }
+    }
 
     _instances.clear();
     _instancesLinear.clear();
@@ -249,7 +252,7 @@ void Scene::culling() {
         });
     }
 
-    std::vector<SortedLight> sortedLights;
+    auto& sortedLights = _sortedLights;
     sortedLights.resize(_visibleLights.size());
 
     const auto& worldToCamera = camera->view();
@@ -327,8 +330,8 @@ void Scene::culling() {
     const auto tileYCount      = height / TILE_SIZE;
     const auto tilesEntryCount = tileXCount * tileYCount * NUM_WORDS;
 
-    std::vector<gerium_uint32_t> lightTilesBits;
-    lightTilesBits.resize(tilesEntryCount);
+    auto& lightTilesBits = _lightTilesBits;
+    lightTilesBits.assign(tilesEntryCount, 0);
 
     gerium_float32_t tileSizeInv = 1.0f / TILE_SIZE;
     gerium_uint32_t tileStride   = tileXCount * NUM_WORDS;
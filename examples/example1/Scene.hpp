@@ -206,6 +206,9 @@ private:
     BVHNode* _bvh{};
     std::vector<Mesh*> _visibleMeshes{};
     std::vector<Light*> _visibleLights{};
+    std::vector<const BVHNode*> _cullingStack{};
+    std::vector<SortedLight> _sortedLights{};
+    std::vector<gerium_uint32_t> _lightTilesBits{};
     std::array<gerium_uint32_t, LIGHT_Z_BINS> _lightsLUT{};
     DescriptorSet _bindlessTextures{};
     Texture _emptyTexture{};
@@ -1610,6 +1610,7 @@ void Application::initialize() {
                                      GERIUM_FEATURE_16_BIT_STORAGE_BIT,
                                  GERIUM_VERSION_ENCODE(1, 0, 0),
                                  debug,
+                                 nullptr,
                                  &_renderer));
     gerium_renderer_set_profiler_enable(_renderer, true);
 
@@ -62,6 +62,7 @@ typedef enum
     GERIUM_RESULT_ERROR_DESCRIPTOR                  = 29,
     GERIUM_RESULT_ERROR_LOAD_TEXTURE                = 30,
     GERIUM_RESULT_ERROR_CHANGE_DISPLAY_MODE         = 31,
+    GERIUM_RESULT_ERROR_FILE_READ                   = 32,
     GERIUM_RESULT_MAX_ENUM                          = 0x7FFFFFFF
 } gerium_result_t;
 
@@ -945,6 +946,59 @@ typedef enum
     GERIUM_SHADER_LANGUAGE_MAX_ENUM = 0x7FFFFFFF
 } gerium_shader_languge_t;
 
+typedef enum
+{
+    GERIUM_TEXTURE_CACHE_MODE_DEFAULT    = 0,
+    GERIUM_TEXTURE_CACHE_MODE_DISABLED   = 1,
+    GERIUM_TEXTURE_CACHE_MODE_COMPRESSED = 2,
+    GERIUM_TEXTURE_CACHE_MODE_MAX_ENUM   = 0x7FFFFFFF
+} gerium_texture_cache_mode_t;
+
+typedef enum
+{
+    GERIUM_PROFILER_SCOPE_TYPE_GPU      = 0,
+    GERIUM_PROFILER_SCOPE_TYPE_CPU      = 1,
+    GERIUM_PROFILER_SCOPE_TYPE_MAX_ENUM = 0x7FFFFFFF
+} gerium_profiler_scope_type_t;
+
+typedef enum
+{
+    GERIUM_MEMORY_CATEGORY_TRANSIENT_TARGET = 0,
+    GERIUM_MEMORY_CATEGORY_RENDER_TARGET    = 1,
+    GERIUM_MEMORY_CATEGORY_TEXTURE          = 2,
+    GERIUM_MEMORY_CATEGORY_GEOMETRY         = 3,
+    GERIUM_MEMORY_CATEGORY_BUFFER_HEAP      = 4,
+    GERIUM_MEMORY_CATEGORY_DYNAMIC          = 5,
+    GERIUM_MEMORY_CATEGORY_STAGING          = 6,
+    GERIUM_MEMORY_CATEGORY_BUFFER           = 7,
+    GERIUM_MEMORY_CATEGORY_RECYCLED         = 8,
+    GERIUM_MEMORY_CATEGORY_MAX_ENUM         = 0x7FFFFFFF
+} gerium_memory_category_t;
+
+typedef enum
+{
+    GERIUM_HITCH_CAUSE_PIPELINE_CREATION     = 0,
+    GERIUM_HITCH_CAUSE_SHADER_COMPILE        = 1,
+    GERIUM_HITCH_CAUSE_FRAME_GRAPH_COMPILE   = 2,
+    GERIUM_HITCH_CAUSE_FRAME_GRAPH_RESIZE    = 3,
+    GERIUM_HITCH_CAUSE_SWAPCHAIN_RECREATION  = 4,
+    GERIUM_HITCH_CAUSE_LARGE_UPLOAD          = 5,
+    GERIUM_HITCH_CAUSE_DESCRIPTOR_ALLOCATION = 6,
+    GERIUM_HITCH_CAUSE_DELETION_BURST        = 7,
+    GERIUM_HITCH_CAUSE_MAX_ENUM              = 0x7FFFFFFF
+} gerium_hitch_cause_t;
+
+typedef enum
+{
+    GERIUM_ALLOCATION_SCOPE_OTHER          = 0,
+    GERIUM_ALLOCATION_SCOPE_RENDERER       = 1,
+    GERIUM_ALLOCATION_SCOPE_FRAME_GRAPH    = 2,
+    GERIUM_ALLOCATION_SCOPE_COMMAND_BUFFER = 3,
+    GERIUM_ALLOCATION_SCOPE_DEVICE         = 4,
+    GERIUM_ALLOCATION_SCOPE_PROFILER       = 5,
+    GERIUM_ALLOCATION_SCOPE_MAX_ENUM       = 0x7FFFFFFF
+} gerium_allocation_scope_t;
+
 typedef gerium_bool_t
 (*gerium_application_frame_func_t)(gerium_application_t application,
                                    gerium_data_t data,
@@ -978,11 +1032,32 @@ typedef gerium_bool_t
                                     gerium_uint32_t total_workers,
                                     gerium_data_t data);
 
+typedef void
+(*gerium_file_read_func_t)(gerium_file_t file,
+                           gerium_result_t result,
+                           gerium_uint32_t bytes_read,
+                           gerium_data_t data);
+
 typedef void
 (*gerium_texture_loaded_func_t)(gerium_renderer_t renderer,
                                 gerium_texture_h texture,
+                                gerium_result_t result,
                                 gerium_data_t data);
 
+typedef struct
+{
+    gerium_resource_type_t type;
+    gerium_buffer_h        buffer;
+    gerium_texture_h       texture;
+    gerium_uint64_t        size;
+    gerium_uint32_t        idle_frames;
+} gerium_eviction_t;
+
+typedef gerium_bool_t
+(*gerium_eviction_func_t)(gerium_renderer_t renderer,
+                          const gerium_eviction_t* eviction,
+                          gerium_data_t data);
+
 typedef struct
 {
     gerium_scancode_t      scancode;
@@ -1043,6 +1118,25 @@ typedef struct
     gerium_utf8_t         name;
 } gerium_texture_info_t;
 
+typedef struct
+{
+    gerium_uint32_t             upload_budget_bytes;
+    gerium_uint32_t             upload_budget_copies;
+    gerium_texture_cache_mode_t texture_cache_mode;
+    gerium_bool_t               texture_streaming;
+    gerium_uint64_t             texture_streaming_budget;
+    gerium_uint32_t             frames_in_flight;
+} gerium_renderer_options_t;
+
+typedef struct
+{
+    gerium_uint32_t pending_textures;
+    gerium_uint32_t pending_uploads;
+    gerium_uint64_t pending_upload_bytes;
+    gerium_uint32_t frame_uploads;
+    gerium_uint64_t frame_upload_bytes;
+} gerium_upload_stats_t;
+
 typedef struct
 {
     gerium_utf8_t    name;
@@ -1051,6 +1145,89 @@ typedef struct
     gerium_uint32_t  depth;
 } gerium_gpu_timestamp_t;
 
+typedef struct
+{
+    gerium_utf8_t                name;
+    gerium_utf8_t                parent;
+    gerium_profiler_scope_type_t type;
+    gerium_uint32_t              depth;
+    gerium_uint32_t              samples;
+    gerium_float64_t             mean;
+    gerium_float64_t             min;
+    gerium_float64_t             max;
+    gerium_float64_t             p50;
+    gerium_float64_t             p95;
+    gerium_float64_t             p99;
+    gerium_float64_t             std_dev;
+} gerium_profiler_scope_stats_t;
+
+typedef struct
+{
+    gerium_utf8_t   name;
+    gerium_uint32_t frame;
+    gerium_uint64_t input_assembly_vertices;
+    gerium_uint64_t input_assembly_primitives;
+    gerium_uint64_t vertex_shader_invocations;
+    gerium_uint64_t clipping_invocations;
+    gerium_uint64_t clipping_primitives;
+    gerium_uint64_t fragment_shader_invocations;
+    gerium_uint64_t compute_shader_invocations;
+    gerium_uint64_t task_shader_invocations;
+    gerium_uint64_t mesh_shader_invocations;
+} gerium_pipeline_statistics_t;
+
+typedef struct
+{
+    gerium_memory_category_t category;
+    gerium_uint32_t          allocation_count;
+    gerium_uint32_t          peak_allocation_count;
+    gerium_uint64_t          current_bytes;
+    gerium_uint64_t          peak_bytes;
+    gerium_uint64_t          aliased_bytes;
+} gerium_memory_stats_t;
+
+typedef struct
+{
+    gerium_utf8_t   name;
+    gerium_uint32_t frame;
+    gerium_uint64_t draws;
+    gerium_uint64_t dispatches;
+    gerium_uint64_t mesh_task_launches;
+    gerium_uint64_t indirect_calls;
+    gerium_uint64_t pipeline_binds;
+    gerium_uint64_t descriptor_set_binds;
+    gerium_uint64_t descriptor_set_allocations;
+    gerium_uint64_t barriers;
+    gerium_uint64_t dynamic_buffer_bytes;
+    gerium_uint64_t uploads;
+} gerium_render_counters_t;
+
+typedef struct
+{
+    gerium_hitch_cause_t cause;
+    gerium_utf8_t        name;
+    gerium_uint32_t      count;
+    gerium_float64_t     elapsed;
+} gerium_hitch_event_t;
+
+typedef struct
+{
+    gerium_uint32_t      frame;
+    gerium_float64_t     elapsed;
+    gerium_float64_t     baseline;
+    gerium_uint32_t      event_count;
+    gerium_hitch_event_t events[8];
+} gerium_hitch_t;
+
+typedef struct
+{
+    gerium_allocation_scope_t scope;
+    gerium_uint32_t           frame;
+    gerium_uint64_t           allocations;
+    gerium_uint64_t           frees;
+    gerium_uint64_t           allocated_bytes;
+} gerium_allocation_stats_t;
+
 typedef struct
 {
     gerium_frame_graph_prepare_func_t prepare;
@@ -1253,6 +1430,13 @@ gerium_file_exists_dir(gerium_utf8_t path);
 gerium_public void
 gerium_file_delete_file(gerium_utf8_t path);
 
+gerium_public gerium_result_t
+gerium_file_mount_archive(gerium_utf8_t path,
+                          gerium_utf8_t mount_point);
+
+gerium_public void
+gerium_file_unmount_archive(gerium_utf8_t path);
+
 gerium_public gerium_result_t
 gerium_file_open(gerium_utf8_t path,
                  gerium_bool_t read_only,
@@ -1291,6 +1475,15 @@ gerium_file_read(gerium_file_t file,
                  gerium_data_t data,
                  gerium_uint32_t size);
 
+gerium_public gerium_result_t
+gerium_file_read_async(gerium_file_t file,
+                       gerium_uint64_t offset,
+                       gerium_data_t buffer,
+                       gerium_uint32_t size,
+                       gerium_file_read_func_t callback,
+                       gerium_signal_t signal,
+                       gerium_data_t data);
+
 gerium_public gerium_data_t
 gerium_file_map(gerium_file_t file);
 
@@ -1459,6 +1652,7 @@ gerium_renderer_create(gerium_application_t application,
                        gerium_feature_flags_t features,
                        gerium_uint32_t version,
                        gerium_bool_t debug,
+                       const gerium_renderer_options_t* options,
                        gerium_renderer_t* renderer);
 
 gerium_public gerium_renderer_t
@@ -1532,6 +1726,33 @@ gerium_renderer_async_load_texture(gerium_renderer_t renderer,
                                    gerium_data_t data,
                                    gerium_texture_h* handle);
 
+gerium_public gerium_result_t
+gerium_renderer_set_load_priority(gerium_renderer_t renderer,
+                                  gerium_texture_h handle,
+                                  gerium_float32_t priority);
+
+gerium_public gerium_result_t
+gerium_renderer_cancel_load(gerium_renderer_t renderer,
+                            gerium_texture_h handle);
+
+gerium_public void
+gerium_renderer_get_upload_stats(gerium_renderer_t renderer,
+                                 gerium_upload_stats_t* stats);
+
+gerium_public void
+gerium_renderer_request_texture_mip(gerium_renderer_t renderer,
+                                    gerium_texture_h handle,
+                                    gerium_uint8_t mip);
+
+gerium_public gerium_result_t
+gerium_renderer_get_streaming_feedback(gerium_renderer_t renderer,
+                                       gerium_buffer_h* handle);
+
+gerium_public void
+gerium_renderer_set_eviction_callback(gerium_renderer_t renderer,
+                                      gerium_eviction_func_t callback,
+                                      gerium_data_t data);
+
 gerium_public gerium_result_t
 gerium_renderer_async_upload_texture_data(gerium_renderer_t renderer,
                                           gerium_texture_h handle,
@@ -1792,6 +2013,82 @@ gerium_profiler_get_gpu_timestamps(gerium_profiler_t profiler,
 gerium_public gerium_uint32_t
 gerium_profiler_get_gpu_total_memory_used(gerium_profiler_t profiler);
 
+gerium_public gerium_result_t
+gerium_profiler_set_history_size(gerium_profiler_t profiler,
+                                 gerium_uint32_t frames);
+
+gerium_public gerium_uint32_t
+gerium_profiler_get_history_size(gerium_profiler_t profiler);
+
+gerium_public void
+gerium_profiler_get_scope_stats(gerium_profiler_t profiler,
+                                gerium_uint32_t* scope_stats_count,
+                                gerium_profiler_scope_stats_t* scope_stats);
+
+gerium_public void
+gerium_profiler_reset_stats(gerium_profiler_t profiler);
+
+gerium_public void
+gerium_profiler_push_cpu(gerium_profiler_t profiler,
+                         gerium_utf8_t name);
+
+gerium_public void
+gerium_profiler_pop_cpu(gerium_profiler_t profiler);
+
+gerium_public gerium_result_t
+gerium_profiler_capture_trace(gerium_profiler_t profiler,
+                              gerium_utf8_t filename,
+                              gerium_uint32_t frames);
+
+gerium_public gerium_bool_t
+gerium_profiler_is_capturing_trace(gerium_profiler_t profiler);
+
+gerium_public gerium_bool_t
+gerium_profiler_get_pipeline_statistics_enable(gerium_profiler_t profiler);
+
+gerium_public void
+gerium_profiler_set_pipeline_statistics_enable(gerium_profiler_t profiler,
+                                               gerium_bool_t enable);
+
+gerium_public void
+gerium_profiler_get_pipeline_statistics(gerium_profiler_t profiler,
+                                        gerium_uint32_t* pipeline_statistics_count,
+                                        gerium_pipeline_statistics_t* pipeline_statistics);
+
+gerium_public void
+gerium_profiler_get_memory_stats(gerium_profiler_t profiler,
+                                 gerium_uint32_t* memory_stats_count,
+                                 gerium_memory_stats_t* memory_stats);
+
+gerium_public void
+gerium_profiler_get_render_counters(gerium_profiler_t profiler,
+                                    gerium_render_counters_t* render_counters);
+
+gerium_public void
+gerium_profiler_get_node_render_counters(gerium_profiler_t profiler,
+                                         gerium_uint32_t* render_counters_count,
+                                         gerium_render_counters_t* render_counters);
+
+gerium_public gerium_result_t
+gerium_profiler_set_hitch_threshold(gerium_profiler_t profiler,
+                                    gerium_float32_t threshold);
+
+gerium_public gerium_float32_t
+gerium_profiler_get_hitch_threshold(gerium_profiler_t profiler);
+
+gerium_public void
+gerium_profiler_get_hitches(gerium_profiler_t profiler,
+                            gerium_uint32_t* hitches_count,
+                            gerium_hitch_t* hitches);
+
+gerium_public void
+gerium_profiler_clear_hitches(gerium_profiler_t profiler);
+
+gerium_public void
+gerium_profiler_get_allocation_stats(gerium_profiler_t profiler,
+                                     gerium_uint32_t* allocation_stats_count,
+                                     gerium_allocation_stats_t* allocation_stats);
+
 GERIUM_END
 
 #endif
@@ -0,0 +1,280 @@
+#include "AllocationCounter.hpp"
+
+namespace gerium {
+
+namespace {
+
+enum Counter {
+    Allocations,
+    Frees,
+    Bytes,
+    CounterCount
+};
+
+// Every thread counts into its own slot, so the operators below never write memory shared with another thread.
+// Threads beyond kMaxThreads running at once share the last slot and pay for an atomic add
+struct ThreadCounters {
+    std::atomic_uint64_t values[kAllocationScopeCount][CounterCount];
+};
+
+constexpr gerium_uint32_t kMaxThreads = 256;
+
+ThreadCounters threadCounters[kMaxThreads + 1];
+std::atomic_bool threadSlotsUsed[kMaxThreads];
+
+thread_local ThreadCounters* currentCounters        = nullptr;
+thread_local gerium_allocation_scope_t currentScope = GERIUM_ALLOCATION_SCOPE_OTHER;
+
+// Returns the slot of the thread when it exits. The values stay in the slot for the next thread, so the totals never
+// go back; allocations made by later thread_local destructors are counted in the shared slot
+struct ThreadSlot {
+    ThreadCounters* counters;
+
+    ~ThreadSlot() {
+        if (counters) {
+            threadSlotsUsed[counters - threadCounters].store(false, std::memory_order_release);
+        }
+        currentCounters = &threadCounters[kMaxThreads];
+    }
+};
+
+thread_local ThreadSlot threadSlot{};
+
+ThreadCounters* acquireCounters() noexcept {
+    for (gerium_uint32_t i = 0; i < kMaxThreads; ++i) {
+        auto& used = threadSlotsUsed[i];
+        if (!used.load(std::memory_order_relaxed) && !used.exchange(true, std::memory_order_acquire)) {
+            return &threadCounters[i];
+        }
+    }
+    return nullptr;
+}
+
+void count(Counter counter, gerium_uint64_t value) noexcept {
+    if (!currentCounters) {
+        threadSlot.counters = acquireCounters();
+        currentCounters     = threadSlot.counters ? threadSlot.counters : &threadCounters[kMaxThreads];
+    }
+
+    auto& slot = currentCounters->values[currentScope][counter];
+    if (currentCounters != &threadCounters[kMaxThreads]) {
+        slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    } else {
+        slot.fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+void countAllocation(size_t size) noexcept {
+    count(Allocations, 1);
+    count(Bytes, size);
+}
+
+void countFree() noexcept {
+    count(Frees, 1);
+}
+
+gerium_allocation_scope_t setAllocationScope(gerium_allocation_scope_t scope) noexcept {
+    return std::exchange(currentScope, scope);
+}
+
+void readAllocationCounters(AllocationCounters (&counters)[kAllocationScopeCount]) noexcept {
+    const auto add = [&counters](const ThreadCounters& thread) {
+        for (size_t scope = 0; scope < kAllocationScopeCount; ++scope) {
+            const auto& values = thread.values[scope];
+            counters[scope].allocations += values[Allocations].load(std::memory_order_relaxed);
+            counters[scope].frees += values[Frees].load(std::memory_order_relaxed);
+            counters[scope].bytes += values[Bytes].load(std::memory_order_relaxed);
+        }
+    };
+
+    std::fill(std::begin(counters), std::end(counters), AllocationCounters{});
+
+    for (const auto& thread : threadCounters) {
+        add(thread);
+    }
+}
+
+} // namespace gerium
+
+#ifdef GERIUM_ALLOCATION_COUNTING
+
+// Replacements of the global allocation functions. They forward to mimalloc where it overrides the allocator and to
+// the C allocator elsewhere, counting every call for the profiler
+
+namespace {
+
+# ifndef GERIUM_MIMALLOC_DISABLE
+
+void* allocate(std::size_t size) {
+    gerium::countAllocation(size);
+    return mi_new(size);
+}
+
+void* allocate(std::size_t size, const std::nothrow_t&) noexcept {
+    gerium::countAllocation(size);
+    return mi_new_nothrow(size);
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment) {
+    gerium::countAllocation(size);
+    return mi_new_aligned(size, static_cast<size_t>(alignment));
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    gerium::countAllocation(size);
+    return mi_new_aligned_nothrow(size, static_cast<size_t>(alignment));
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr) {
+        gerium::countFree();
+        mi_free(ptr);
+    }
+}
+
+void deallocate(void* ptr, std::align_val_t alignment) noexcept {
+    if (ptr) {
+        gerium::countFree();
+        mi_free_aligned(ptr, static_cast<size_t>(alignment));
+    }
+}
+
+# else
+
+void* allocate(std::size_t size, const std::nothrow_t&) noexcept {
+    gerium::countAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* allocate(std::size_t size) {
+    if (auto ptr = allocate(size, std::nothrow)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    gerium::countAllocation(size);
+#  ifdef GERIUM_PLATFORM_WINDOWS
+    return _aligned_malloc(size ? size : 1, static_cast<size_t>(alignment));
+#  else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, std::max(static_cast<size_t>(alignment), sizeof(void*)), size ? size : 1)) {
+        return nullptr;
+    }
+    return ptr;
+#  endif
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment) {
+    if (auto ptr = allocate(size, alignment, std::nothrow)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr) {
+        gerium::countFree();
+        std::free(ptr);
+    }
+}
+
+void deallocate(void* ptr, std::align_val_t) noexcept {
+#  ifdef GERIUM_PLATFORM_WINDOWS
+    if (ptr) {
+        gerium::countFree();
+        _aligned_free(ptr);
+    }
+#  else
+    deallocate(ptr);
+#  endif
+}
+
+# endif
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept {
+    return allocate(size, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return allocate(size, tag);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+    return allocate(size, alignment, tag);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+    return allocate(size, alignment, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    deallocate(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    deallocate(ptr, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate(ptr, alignment);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(ptr, alignment);
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef GERIUM_ALLOCATION_COUNTER_HPP
+#define GERIUM_ALLOCATION_COUNTER_HPP
+
+#include "Gerium.hpp"
+
+namespace gerium {
+
+constexpr auto kAllocationScopeCount = size_t(GERIUM_ALLOCATION_SCOPE_PROFILER) + 1;
+
+struct AllocationCounters {
+    gerium_uint64_t allocations;
+    gerium_uint64_t frees;
+    gerium_uint64_t bytes;
+};
+
+void countAllocation(size_t size) noexcept;
+void countFree() noexcept;
+
+gerium_allocation_scope_t setAllocationScope(gerium_allocation_scope_t scope) noexcept;
+
+void readAllocationCounters(AllocationCounters (&counters)[kAllocationScopeCount]) noexcept;
+
+class AllocationScope final {
+public:
+    explicit AllocationScope(gerium_allocation_scope_t scope) noexcept : _previous(setAllocationScope(scope)) {
+    }
+
+    ~AllocationScope() {
+        setAllocationScope(_previous);
+    }
+
+    AllocationScope(const AllocationScope&)            = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    gerium_allocation_scope_t _previous;
+};
+
+} // namespace gerium
+
+#endif
@@ -1,4 +1,5 @@
 #include "AndroidFile.hpp"
+#include "../Archive.hpp"
 
 namespace gerium {
 
@@ -122,6 +123,9 @@ gerium_utf8_t File::getAppDir() noexcept {
 }
 
 bool File::existsFile(gerium_utf8_t path) noexcept {
+    if (Archive::exists(path)) {
+        return true;
+    }
     std::filesystem::path file = path;
     if (std::filesystem::exists(file) && !std::filesystem::is_directory(file)) {
         return true;
@@ -154,6 +158,11 @@ using namespace gerium;
 using namespace gerium::android;
 
 gerium_result_t gerium_file_open(gerium_utf8_t path, gerium_bool_t read_only, gerium_file_t* file) {
+    if (read_only) {
+        if (auto result = Archive::open(path, file); result != GERIUM_RESULT_ERROR_NOT_FOUND) {
+            return result;
+        }
+    }
     return Object::create<AndroidFile>(*file, path, read_only != 0);
 }
 
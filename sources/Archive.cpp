@@ -0,0 +1,175 @@
+#include "Archive.hpp"
+#include "ArchiveFile.hpp"
+
+namespace gerium {
+
+Archive::Archive(gerium_utf8_t path, gerium_utf8_t mountPoint) :
+    _path(std::filesystem::path(path).lexically_normal().string()),
+    _mountPoint(std::filesystem::path(mountPoint).lexically_normal()),
+    _data(nullptr),
+    _header(nullptr),
+    _entries(nullptr),
+    _strings(nullptr) {
+    _file = File::open(path, true);
+
+    const auto size = _file->getSize();
+    if (size < sizeof(archive::Header)) {
+        error(GERIUM_RESULT_ERROR_FILE_OPEN);
+    }
+
+    _data = (const gerium_uint8_t*) _file->map();
+    if (!_data) {
+        error(GERIUM_RESULT_ERROR_FILE_OPEN);
+    }
+
+    _header = (const archive::Header*) _data;
+    if (memcmp(_header->magic, archive::kMagic, sizeof(archive::kMagic)) != 0 ||
+        _header->version != archive::kVersion) {
+        error(GERIUM_RESULT_ERROR_FILE_OPEN);
+    }
+
+    // Written as offset > limit || size > limit - offset, so crafted offsets and sizes cannot wrap around
+    const auto inRange = [](gerium_uint64_t offset, gerium_uint64_t length, gerium_uint64_t limit) {
+        return offset <= limit && length <= limit - offset;
+    };
+
+    const auto entriesSize = gerium_uint64_t(_header->entryCount) * sizeof(archive::Entry);
+    if (!inRange(_header->entriesOffset, entriesSize, size) ||
+        !inRange(_header->stringsOffset, _header->stringsSize, size)) {
+        error(GERIUM_RESULT_ERROR_FILE_OPEN);
+    }
+
+    _entries = (const archive::Entry*) (_data + _header->entriesOffset);
+    _strings = (const char*) (_data + _header->stringsOffset);
+
+    for (gerium_uint32_t i = 0; i < _header->entryCount; ++i) {
+        const auto& entry = _entries[i];
+        if (!inRange(entry.offset, entry.storedSize, size) ||
+            !inRange(entry.nameOffset, entry.nameLength, _header->stringsSize) ||
+            (entry.compression == archive::Compression::None && entry.size != entry.storedSize)) {
+            error(GERIUM_RESULT_ERROR_FILE_OPEN);
+        }
+    }
+}
+
+const std::string& Archive::path() const noexcept {
+    return _path;
+}
+
+const archive::Entry* Archive::find(gerium_utf8_t path) const noexcept {
+    std::string name;
+    try {
+        name = relative(path);
+    } catch (...) {
+        return nullptr;
+    }
+
+    if (name.empty()) {
+        return nullptr;
+    }
+
+    const auto key   = hash(name, archive::kHashSeed);
+    const auto first = _entries;
+    const auto last  = _entries + _header->entryCount;
+
+    auto it = std::lower_bound(first, last, key, [](const archive::Entry& entry, gerium_uint64_t key) {
+        return entry.hash < key;
+    });
+
+    for (; it != last && it->hash == key; ++it) {
+        if (std::string_view(_strings + it->nameOffset, it->nameLength) == name) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+gerium_cdata_t Archive::data(const archive::Entry& entry) const noexcept {
+    return _data + entry.offset;
+}
+
+File* Archive::file() noexcept {
+    return _file.get();
+}
+
+void Archive::mount(gerium_utf8_t path, gerium_utf8_t mountPoint) {
+    auto archive = ObjectPtr(new Archive(path, mountPoint ? mountPoint : File::getAppDir()), false);
+
+    marl::lock lock(_mountsMutex);
+    for (const auto& mounted : _mounts) {
+        if (mounted->path() == archive->path()) {
+            error(GERIUM_RESULT_ERROR_ALREADY_EXISTS);
+        }
+    }
+    _mounts.push_back(std::move(archive));
+    _mountCount = (gerium_uint32_t) _mounts.size();
+}
+
+void Archive::unmount(gerium_utf8_t path) noexcept {
+    const auto normalPath = std::filesystem::path(path).lexically_normal().string();
+
+    marl::lock lock(_mountsMutex);
+    std::erase_if(_mounts, [&normalPath](const auto& archive) {
+        return archive->path() == normalPath;
+    });
+    _mountCount = (gerium_uint32_t) _mounts.size();
+}
+
+bool Archive::exists(gerium_utf8_t path) noexcept {
+    return lookup(path).second != nullptr;
+}
+
+gerium_result_t Archive::open(gerium_utf8_t path, gerium_file_t* file) noexcept {
+    auto [archive, entry] = lookup(path);
+    if (!entry) {
+        return GERIUM_RESULT_ERROR_NOT_FOUND;
+    }
+    return Object::create<ArchiveFile>(*file, archive, *entry);
+}
+
+std::string Archive::relative(gerium_utf8_t path) const {
+    auto file = std::filesystem::path(path).lexically_normal();
+    if (file.is_absolute()) {
+        file = file.lexically_relative(_mountPoint);
+    }
+    if (file.empty() || *file.begin() == "..") {
+        return {};
+    }
+    return file.generic_string();
+}
+
+std::pair<ObjectPtr<Archive>, const archive::Entry*> Archive::lookup(gerium_utf8_t path) noexcept {
+    if (_mountCount == 0 || !path) {
+        return {};
+    }
+
+    marl::lock lock(_mountsMutex);
+    for (auto it = _mounts.rbegin(); it != _mounts.rend(); ++it) {
+        if (auto entry = (*it)->find(path)) {
+            return { *it, entry };
+        }
+    }
+    return {};
+}
+
+marl::mutex Archive::_mountsMutex;
+
+std::vector<ObjectPtr<Archive>> Archive::_mounts;
+
+std::atomic_uint32_t Archive::_mountCount;
+
+} // namespace gerium
+
+using namespace gerium;
+
+gerium_result_t gerium_file_mount_archive(gerium_utf8_t path, gerium_utf8_t mount_point) {
+    GERIUM_ASSERT_ARG(path);
+    GERIUM_BEGIN_SAFE_BLOCK
+        Archive::mount(path, mount_point);
+    GERIUM_END_SAFE_BLOCK
+}
+
+void gerium_file_unmount_archive(gerium_utf8_t path) {
+    assert(path);
+    Archive::unmount(path);
+}
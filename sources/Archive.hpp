@@ -0,0 +1,44 @@
+#ifndef GERIUM_ARCHIVE_HPP
+#define GERIUM_ARCHIVE_HPP
+
+#include "ArchiveFormat.hpp"
+#include "File.hpp"
+
+namespace gerium {
+
+class Archive final : public Object {
+public:
+    Archive(gerium_utf8_t path, gerium_utf8_t mountPoint);
+
+    [[nodiscard]] const std::string& path() const noexcept;
+    [[nodiscard]] const archive::Entry* find(gerium_utf8_t path) const noexcept;
+    [[nodiscard]] gerium_cdata_t data(const archive::Entry& entry) const noexcept;
+    [[nodiscard]] File* file() noexcept;
+
+    static void mount(gerium_utf8_t path, gerium_utf8_t mountPoint);
+    static void unmount(gerium_utf8_t path) noexcept;
+
+    [[nodiscard]] static bool exists(gerium_utf8_t path) noexcept;
+    [[nodiscard]] static gerium_result_t open(gerium_utf8_t path, gerium_file_t* file) noexcept;
+
+private:
+    [[nodiscard]] std::string relative(gerium_utf8_t path) const;
+
+    static std::pair<ObjectPtr<Archive>, const archive::Entry*> lookup(gerium_utf8_t path) noexcept;
+
+    std::string _path;
+    std::filesystem::path _mountPoint;
+    ObjectPtr<File> _file;
+    const gerium_uint8_t* _data;
+    const archive::Header* _header;
+    const archive::Entry* _entries;
+    const char* _strings;
+
+    static marl::mutex _mountsMutex;
+    static std::vector<ObjectPtr<Archive>> _mounts;
+    static std::atomic_uint32_t _mountCount;
+};
+
+} // namespace gerium
+
+#endif
@@ -0,0 +1,93 @@
+#include "ArchiveFile.hpp"
+
+namespace gerium {
+
+ArchiveFile::ArchiveFile(ObjectPtr<Archive> archive, const archive::Entry& entry) :
+    File(true),
+    _archive(archive),
+    _offset(entry.offset),
+    _size(entry.size),
+    _position(0),
+    _data((const gerium_uint8_t*) archive->data(entry)) {
+    switch (entry.compression) {
+        case archive::Compression::None:
+            break;
+        case archive::Compression::Zstd: {
+            _buffer          = std::make_unique<gerium_uint8_t[]>(_size);
+            const auto bytes = ZSTD_decompress(_buffer.get(), _size, _data, entry.storedSize);
+            if (ZSTD_isError(bytes) || bytes != _size) {
+                error(GERIUM_RESULT_ERROR_FILE_READ);
+            }
+            _data = _buffer.get();
+            break;
+        }
+        default:
+            error(GERIUM_RESULT_ERROR_NOT_IMPLEMENTED);
+            break;
+    }
+}
+
+gerium_uint64_t ArchiveFile::onGetSize() noexcept {
+    return _size;
+}
+
+void ArchiveFile::onSeek(gerium_uint64_t offset, gerium_file_seek_t seek) noexcept {
+    switch (seek) {
+        case GERIUM_FILE_SEEK_BEGIN:
+            _position = offset;
+            break;
+        case GERIUM_FILE_SEEK_CURRENT:
+            _position += offset;
+            break;
+        case GERIUM_FILE_SEEK_END:
+            _position = _size + offset;
+            break;
+        default:
+            assert(!"unreachable code");
+            break;
+    }
+}
+
+void ArchiveFile::onWrite(gerium_cdata_t data, gerium_uint32_t size) {
+    error(GERIUM_RESULT_ERROR_FILE_WRITE);
+}
+
+gerium_uint32_t ArchiveFile::onRead(gerium_data_t data, gerium_uint32_t size) noexcept {
+    const auto read = onReadAt(_position, data, size);
+    _position += read;
+    return read;
+}
+
+gerium_data_t ArchiveFile::onMap() noexcept {
+    return (gerium_data_t) _data;
+}
+
+gerium_uint32_t ArchiveFile::onReadAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) {
+    if (offset >= _size) {
+        return 0;
+    }
+    const auto read = (gerium_uint32_t) std::min(gerium_uint64_t(size), _size - offset);
+    memcpy(data, _data + offset, read);
+    return read;
+}
+
+void ArchiveFile::onReadAsync(FileReadRequest* request) {
+    if (_buffer || request->offset >= _size) {
+        File::onReadAsync(request);
+        return;
+    }
+
+    const auto size = (gerium_uint32_t) std::min(gerium_uint64_t(request->size), _size - request->offset);
+    _archive->file()->readAsync(_offset + request->offset, request->data, size, readCompleted, nullptr, request);
+}
+
+void ArchiveFile::readCompleted(gerium_file_t file,
+                                gerium_result_t result,
+                                gerium_uint32_t bytesRead,
+                                gerium_data_t data) {
+    auto request       = (FileReadRequest*) data;
+    request->bytesRead = bytesRead;
+    completeRead(request, result);
+}
+
+} // namespace gerium
@@ -0,0 +1,33 @@
+#ifndef GERIUM_ARCHIVE_FILE_HPP
+#define GERIUM_ARCHIVE_FILE_HPP
+
+#include "Archive.hpp"
+
+namespace gerium {
+
+class ArchiveFile final : public File {
+public:
+    ArchiveFile(ObjectPtr<Archive> archive, const archive::Entry& entry);
+
+private:
+    gerium_uint64_t onGetSize() noexcept override;
+    void onSeek(gerium_uint64_t offset, gerium_file_seek_t seek) noexcept override;
+    void onWrite(gerium_cdata_t data, gerium_uint32_t size) override;
+    gerium_uint32_t onRead(gerium_data_t data, gerium_uint32_t size) noexcept override;
+    gerium_data_t onMap() noexcept override;
+    gerium_uint32_t onReadAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) override;
+    void onReadAsync(FileReadRequest* request) override;
+
+    static void readCompleted(gerium_file_t file, gerium_result_t result, gerium_uint32_t bytesRead, gerium_data_t data);
+
+    ObjectPtr<Archive> _archive;
+    gerium_uint64_t _offset;
+    gerium_uint64_t _size;
+    gerium_uint64_t _position;
+    const gerium_uint8_t* _data;
+    std::unique_ptr<gerium_uint8_t[]> _buffer;
+};
+
+} // namespace gerium
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef GERIUM_ARCHIVE_FORMAT_HPP
+#define GERIUM_ARCHIVE_FORMAT_HPP
+
+#include <cstdint>
+
+namespace gerium::archive {
+
+// Layout: Header | aligned data chunks | Entry[entryCount] sorted by hash | string table.
+// All values are little endian, paths are stored relative to the packed directory with '/' separators.
+
+constexpr char kMagic[8]     = { 'G', 'E', 'R', 'I', 'U', 'M', 'P', 'K' };
+constexpr uint32_t kVersion  = 1;
+constexpr uint32_t kHashSeed = 0;
+
+enum class Compression : uint32_t {
+    None = 0,
+    Zstd = 1
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;
+    uint32_t reserved;
+    uint64_t entriesOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+struct Entry {
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t storedSize;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    Compression compression;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 48, "unexpected archive header size");
+static_assert(sizeof(Entry) == 48, "unexpected archive entry size");
+
+} // namespace gerium::archive
+
+#endif
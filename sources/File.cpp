@@ -1,4 +1,5 @@
 #include "File.hpp"
+#include "FileReadPool.hpp"
 
 namespace gerium {
 
@@ -29,6 +30,35 @@ gerium_uint32_t File::read(gerium_data_t data, gerium_uint32_t size) noexcept {
     return onRead(data, size);
 }
 
+gerium_uint32_t File::readAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) {
+    return onReadAt(offset, data, size);
+}
+
+void File::readAsync(gerium_uint64_t offset,
+                     gerium_data_t data,
+                     gerium_uint32_t size,
+                     gerium_file_read_func_t callback,
+                     Signal* signal,
+                     gerium_data_t userData) {
+    auto request      = new FileReadRequest{};
+    request->offset   = offset;
+    request->data     = data;
+    request->size     = size;
+    request->callback = callback;
+    request->userData = userData;
+    request->signal   = signal;
+    submitRead(request);
+}
+
+void File::readAsync(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size, marl::Event event) {
+    auto request    = new FileReadRequest{};
+    request->offset = offset;
+    request->data   = data;
+    request->size   = size;
+    request->event  = event;
+    submitRead(request);
+}
+
 gerium_data_t File::map() noexcept {
     return onMap();
 }
@@ -49,6 +79,43 @@ ObjectPtr<File> File::create(gerium_utf8_t path, gerium_uint32_t size) {
     return {alias_cast<File*>(file), false};
 }
 
+void File::completeRead(FileReadRequest* request, gerium_result_t result) noexcept {
+    if (result == GERIUM_RESULT_SUCCESS && request->bytesRead != request->size) {
+        result = GERIUM_RESULT_ERROR_FILE_READ;
+    }
+    if (request->callback) {
+        request->callback(request->file, result, request->bytesRead, request->userData);
+    }
+    if (request->signal) {
+        request->signal->set();
+    }
+    if (request->event) {
+        request->event->signal();
+    }
+    request->file->destroy();
+    delete request;
+}
+
+void File::onReadAsync(FileReadRequest* request) {
+    FileReadPool::instance().submit(request);
+}
+
+void File::submitRead(FileReadRequest* request) {
+    request->file = this;
+    reference();
+    if (request->size == 0) {
+        completeRead(request, GERIUM_RESULT_SUCCESS);
+        return;
+    }
+    try {
+        onReadAsync(request);
+    } catch (...) {
+        destroy();
+        delete request;
+        throw;
+    }
+}
+
 } // namespace gerium
 
 using namespace gerium;
@@ -110,6 +177,20 @@ gerium_uint32_t gerium_file_read(gerium_file_t file, gerium_data_t data, gerium_
     return alias_cast<File*>(file)->read(data, size);
 }
 
+gerium_result_t gerium_file_read_async(gerium_file_t file,
+                                       gerium_uint64_t offset,
+                                       gerium_data_t buffer,
+                                       gerium_uint32_t size,
+                                       gerium_file_read_func_t callback,
+                                       gerium_signal_t signal,
+                                       gerium_data_t data) {
+    assert(file);
+    GERIUM_ASSERT_ARG(buffer || size == 0);
+    GERIUM_BEGIN_SAFE_BLOCK
+        alias_cast<File*>(file)->readAsync(offset, buffer, size, callback, alias_cast<Signal*>(signal), data);
+    GERIUM_END_SAFE_BLOCK
+}
+
 gerium_data_t gerium_file_map(gerium_file_t file) {
     assert(file);
     return alias_cast<File*>(file)->map();
@@ -2,11 +2,26 @@
 #define GERIUM_FILE_HPP
 
 #include "ObjectPtr.hpp"
+#include "Signal.hpp"
 
 struct _gerium_file : public gerium::Object {};
 
 namespace gerium {
 
+class File;
+
+struct FileReadRequest {
+    File* file;
+    gerium_uint64_t offset;
+    gerium_data_t data;
+    gerium_uint32_t size;
+    gerium_uint32_t bytesRead;
+    gerium_file_read_func_t callback;
+    gerium_data_t userData;
+    ObjectPtr<Signal> signal;
+    std::optional<marl::Event> event;
+};
+
 class File : public _gerium_file {
 public:
     explicit File(bool readOnly) noexcept;
@@ -16,6 +31,14 @@ public:
     void seek(gerium_uint64_t offset, gerium_file_seek_t seek) noexcept;
     void write(gerium_cdata_t data, gerium_uint32_t size);
     gerium_uint32_t read(gerium_data_t data, gerium_uint32_t size) noexcept;
+    gerium_uint32_t readAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size);
+    void readAsync(gerium_uint64_t offset,
+                   gerium_data_t data,
+                   gerium_uint32_t size,
+                   gerium_file_read_func_t callback,
+                   Signal* signal,
+                   gerium_data_t userData);
+    void readAsync(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size, marl::Event event);
     [[nodiscard]] gerium_data_t map() noexcept;
 
     [[nodiscard]] static ObjectPtr<File> open(gerium_utf8_t path, bool readOnly);
@@ -28,6 +51,11 @@ public:
     [[nodiscard]] static bool existsDir(gerium_utf8_t path) noexcept;
     static void deleteFile(gerium_utf8_t path) noexcept;
 
+    static void completeRead(FileReadRequest* request, gerium_result_t result) noexcept;
+
+protected:
+    virtual void onReadAsync(FileReadRequest* request);
+
 private:
     virtual gerium_uint64_t onGetSize() noexcept                                      = 0;
     virtual void onSeek(gerium_uint64_t offset, gerium_file_seek_t seek) noexcept     = 0;
@@ -35,6 +63,10 @@ private:
     virtual gerium_uint32_t onRead(gerium_data_t data, gerium_uint32_t size) noexcept = 0;
     virtual gerium_data_t onMap() noexcept                                            = 0;
 
+    virtual gerium_uint32_t onReadAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) = 0;
+
+    void submitRead(FileReadRequest* request);
+
     bool _readOnly;
 };
 
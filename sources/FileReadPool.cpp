@@ -0,0 +1,73 @@
+#include "FileReadPool.hpp"
+
+namespace gerium {
+
+FileReadPool::FileReadPool() : _shutdown(false) {
+    const auto count = std::clamp(marl::Thread::numLogicalCPUs() / 2, (unsigned int) 2, (unsigned int) 8);
+    _threads.reserve(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        _threads.emplace_back([this]() {
+            worker();
+        });
+    }
+}
+
+FileReadPool::~FileReadPool() {
+    {
+        marl::lock lock(_mutex);
+        _shutdown = true;
+    }
+    _condition.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void FileReadPool::submit(FileReadRequest* request) {
+    {
+        marl::lock lock(_mutex);
+        _requests.push(request);
+    }
+    _condition.notify_one();
+}
+
+FileReadPool& FileReadPool::instance() {
+    static FileReadPool pool;
+    return pool;
+}
+
+void FileReadPool::worker() noexcept {
+    while (true) {
+        FileReadRequest* request = nullptr;
+        {
+            marl::lock lock(_mutex);
+            _condition.wait(lock, [this]() {
+                return _shutdown || !_requests.empty();
+            });
+            if (_requests.empty()) {
+                return;
+            }
+            request = _requests.front();
+            _requests.pop();
+        }
+
+        auto result = GERIUM_RESULT_SUCCESS;
+        auto data   = (gerium_uint8_t*) request->data;
+        try {
+            while (request->bytesRead < request->size) {
+                const auto read = request->file->readAt(request->offset + request->bytesRead,
+                                                        data + request->bytesRead,
+                                                        request->size - request->bytesRead);
+                if (read == 0) {
+                    break;
+                }
+                request->bytesRead += read;
+            }
+        } catch (const Exception& exc) {
+            result = exc.result();
+        }
+        File::completeRead(request, result);
+    }
+}
+
+} // namespace gerium
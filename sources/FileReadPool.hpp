@@ -0,0 +1,32 @@
+#ifndef GERIUM_FILE_READ_POOL_HPP
+#define GERIUM_FILE_READ_POOL_HPP
+
+#include "File.hpp"
+
+namespace gerium {
+
+class FileReadPool final {
+public:
+    FileReadPool();
+    ~FileReadPool();
+
+    FileReadPool(const FileReadPool&)            = delete;
+    FileReadPool& operator=(const FileReadPool&) = delete;
+
+    void submit(FileReadRequest* request);
+
+    static FileReadPool& instance();
+
+private:
+    void worker() noexcept;
+
+    std::vector<std::thread> _threads;
+    marl::mutex _mutex;
+    marl::ConditionVariable _condition;
+    std::queue<FileReadRequest*> _requests;
+    bool _shutdown;
+};
+
+} // namespace gerium
+
+#endif
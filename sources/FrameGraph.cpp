@@ -179,6 +179,8 @@ void FrameGraph::compile() {
         return;
     }
 
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_FRAME_GRAPH);
+
     for (gerium_uint32_t i = 0; i < _nodeGraphCount; ++i) {
         auto node       = _nodes.access(_nodeGraph[i]);
         node->edgeCount = 0;
@@ -286,7 +288,8 @@ void FrameGraph::compile() {
                     TextureCreation creation{};
                     creation.setFormat(info.format, info.depth <= 1 ? GERIUM_TEXTURE_TYPE_2D : GERIUM_TEXTURE_TYPE_3D)
                         .setSize(info.width, info.height, info.depth)
-                        .setFlags(1, info.layers, true, node->compute);
+                        .setFlags(1, info.layers, true, node->compute)
+                        .setTransient(!resource->saveForNextFrame);
 
                     if (!_freeList.empty()) {
                         const auto size =
@@ -431,6 +434,8 @@ void FrameGraph::resize(gerium_uint16_t oldWidth,
                         gerium_uint16_t newWidth,
                         gerium_uint16_t oldHeight,
                         gerium_uint16_t newHeight) {
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_FRAME_GRAPH);
+
     auto scaleX = gerium_float64_t(newWidth) / oldWidth;
     auto scaleY = gerium_float64_t(newHeight) / oldHeight;
 
@@ -546,6 +551,10 @@ void FrameGraph::fillExternalResource(FrameGraphResourceHandle handle) noexcept
     }
 }
 
+bool FrameGraph::hasChanges() const noexcept {
+    return _hasChanges;
+}
+
 gerium_uint32_t FrameGraph::nodeCount() const noexcept {
     return _sortedNodeGraphCount;
 }
@@ -114,6 +114,7 @@ public:
                 gerium_uint16_t newWidth,
                 gerium_uint16_t oldHeight,
                 gerium_uint16_t newHeight);
+    bool hasChanges() const noexcept;
 
     const FrameGraphResource* getResource(FrameGraphResourceHandle handle) const noexcept;
     const FrameGraphResource* getResource(gerium_utf8_t name) const noexcept;
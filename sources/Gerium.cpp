@@ -1,6 +1,7 @@
 #include "Gerium.hpp"
 
-#ifndef GERIUM_MIMALLOC_DISABLE
+// With allocation counting the global operators are replaced in AllocationCounter.cpp instead
+#if !defined(GERIUM_MIMALLOC_DISABLE) && !defined(GERIUM_ALLOCATION_COUNTING)
 # include <mimalloc-new-delete.h>
 #endif
 
@@ -153,6 +154,9 @@ gerium_utf8_t gerium_result_to_string(gerium_result_t result) {
         case GERIUM_RESULT_ERROR_CHANGE_DISPLAY_MODE:
             return "failed to change display mode";
 
+        case GERIUM_RESULT_ERROR_FILE_READ:
+            return "error reading from file";
+
         default:
             return "<unknown result>";
     }
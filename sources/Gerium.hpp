@@ -30,6 +30,8 @@ inline void mi_free(void* p) mi_attr_noexcept {
 #include <cmrc/cmrc.hpp>
 CMRC_DECLARE(gerium::resources);
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
@@ -38,6 +40,7 @@ CMRC_DECLARE(gerium::resources);
 #include <list>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -131,6 +134,9 @@ CMRC_DECLARE(gerium::resources);
 // Ktx
 #include <ktxvulkan.h>
 
+// zstd
+#include <zstd.h>
+
 // Stb
 #include <stb_image.h>
 
@@ -22,13 +22,15 @@ struct FramebufferHandle : Handle {};
 enum class ResourceUsageType : uint8_t {
     Immutable,
     Dynamic,
-    Staging
+    Staging,
+    Readback
 };
 
 enum class TextureFlags : uint8_t {
     None         = 0,
     RenderTarget = 1,
-    Compute      = 2
+    Compute      = 2,
+    Transient    = 4
 };
 GERIUM_FLAGS(TextureFlags)
 
@@ -124,6 +126,11 @@ struct TextureCreation {
         return *this;
     }
 
+    TextureCreation& setTransient(bool transient) {
+        this->flags |= transient ? TextureFlags::Transient : TextureFlags::None;
+        return *this;
+    }
+
     TextureCreation& setFormat(gerium_format_t format, gerium_texture_type_t type) {
         this->format = format;
         this->type   = type;
@@ -1,4 +1,6 @@
 #include "LinuxFile.hpp"
+#include "../Archive.hpp"
+#include "LinuxIoRing.hpp"
 
 #include <fstream>
 
@@ -22,6 +24,12 @@ LinuxFile::~LinuxFile() {
     }
 }
 
+void LinuxFile::onReadAsync(FileReadRequest* request) {
+    if (auto& ring = LinuxIoRing::instance(); !ring.isSupported() || !ring.submit(descriptor(), request)) {
+        nix::UnixFile::onReadAsync(request);
+    }
+}
+
 std::string LinuxFile::createTempFile() {
     _file = tmpfile();
 
@@ -63,6 +71,9 @@ gerium_utf8_t File::getAppDir() noexcept {
 }
 
 bool File::existsFile(gerium_utf8_t path) noexcept {
+    if (Archive::exists(path)) {
+        return true;
+    }
     std::filesystem::path file = path;
     return std::filesystem::exists(file) && !std::filesystem::is_directory(file);
 }
@@ -84,6 +95,11 @@ using namespace gerium;
 using namespace gerium::linux;
 
 gerium_result_t gerium_file_open(gerium_utf8_t path, gerium_bool_t read_only, gerium_file_t* file) {
+    if (read_only) {
+        if (auto result = Archive::open(path, file); result != GERIUM_RESULT_ERROR_NOT_FOUND) {
+            return result;
+        }
+    }
     return Object::create<LinuxFile>(*file, path, read_only != 0);
 }
 
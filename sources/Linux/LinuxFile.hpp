@@ -14,6 +14,8 @@ public:
     ~LinuxFile() override;
 
 private:
+    void onReadAsync(FileReadRequest* request) override;
+
     std::string createTempFile();
 
     FILE* _file{};
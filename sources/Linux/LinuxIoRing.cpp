@@ -0,0 +1,272 @@
+#include "LinuxIoRing.hpp"
+
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace gerium::linux {
+
+static int ioUringSetup(unsigned entries, io_uring_params* params) noexcept {
+    return (int) ::syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int ioUringEnter(int ring, unsigned toSubmit, unsigned minComplete, unsigned flags) noexcept {
+    return (int) ::syscall(__NR_io_uring_enter, ring, toSubmit, minComplete, flags, nullptr, 0);
+}
+
+template <typename T>
+static T* offsetPtr(void* ptr, gerium_uint32_t offset) noexcept {
+    return (T*) ((gerium_uint8_t*) ptr + offset);
+}
+
+LinuxIoRing::LinuxIoRing(gerium_uint32_t entries) :
+    _ring(-1),
+    _entries(0),
+    _inFlight(0),
+    _shutdown(false),
+    _sqPtr(MAP_FAILED),
+    _sqSize(0),
+    _cqPtr(MAP_FAILED),
+    _cqSize(0),
+    _sqes((io_uring_sqe*) MAP_FAILED),
+    _sqesSize(0),
+    _sqHead(nullptr),
+    _sqTail(nullptr),
+    _sqMask(nullptr),
+    _sqArray(nullptr),
+    _cqHead(nullptr),
+    _cqTail(nullptr),
+    _cqMask(nullptr),
+    _cqes(nullptr) {
+    io_uring_params params{};
+    _ring = ioUringSetup(entries, &params);
+    if (_ring < 0) {
+        return;
+    }
+
+    _sqSize   = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqSize   = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    const auto singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+    }
+
+    _sqPtr = ::mmap(nullptr, _sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQ_RING);
+    if (_sqPtr != MAP_FAILED) {
+        _cqPtr = singleMap ? _sqPtr
+                           : ::mmap(nullptr,
+                                    _cqSize,
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_POPULATE,
+                                    _ring,
+                                    IORING_OFF_CQ_RING);
+    }
+    if (_cqPtr != MAP_FAILED) {
+        _sqes = (io_uring_sqe*) ::mmap(
+            nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQES);
+    }
+
+    if (_sqes == MAP_FAILED) {
+        if (_cqPtr != MAP_FAILED && _cqPtr != _sqPtr) {
+            ::munmap(_cqPtr, _cqSize);
+        }
+        if (_sqPtr != MAP_FAILED) {
+            ::munmap(_sqPtr, _sqSize);
+        }
+        ::close(_ring);
+        _ring = -1;
+        return;
+    }
+
+    _sqHead  = offsetPtr<unsigned>(_sqPtr, params.sq_off.head);
+    _sqTail  = offsetPtr<unsigned>(_sqPtr, params.sq_off.tail);
+    _sqMask  = offsetPtr<unsigned>(_sqPtr, params.sq_off.ring_mask);
+    _sqArray = offsetPtr<unsigned>(_sqPtr, params.sq_off.array);
+    _cqHead  = offsetPtr<unsigned>(_cqPtr, params.cq_off.head);
+    _cqTail  = offsetPtr<unsigned>(_cqPtr, params.cq_off.tail);
+    _cqMask  = offsetPtr<unsigned>(_cqPtr, params.cq_off.ring_mask);
+    _cqes    = offsetPtr<io_uring_cqe>(_cqPtr, params.cq_off.cqes);
+    _entries = params.sq_entries;
+
+    _thread = std::thread([this]() {
+        completionThread();
+    });
+}
+
+LinuxIoRing::~LinuxIoRing() {
+    if (_ring < 0) {
+        return;
+    }
+
+    bool pushed;
+    {
+        marl::lock lock(_mutex);
+        _shutdown = true;
+        _condition.wait(lock, [this]() {
+            return _inFlight < _entries;
+        });
+        if ((pushed = push(nullptr))) {
+            ++_inFlight;
+        }
+    }
+    if (!pushed) {
+        _thread.detach();
+        return;
+    }
+    _thread.join();
+
+    ::munmap(_sqes, _sqesSize);
+    if (_cqPtr != _sqPtr) {
+        ::munmap(_cqPtr, _cqSize);
+    }
+    ::munmap(_sqPtr, _sqSize);
+    ::close(_ring);
+}
+
+bool LinuxIoRing::isSupported() const noexcept {
+    return _ring >= 0;
+}
+
+bool LinuxIoRing::submit(int fd, FileReadRequest* request) {
+    auto operation          = new Operation{};
+    operation->request      = request;
+    operation->fd           = fd;
+    operation->iov.iov_base = request->data;
+    operation->iov.iov_len  = request->size;
+
+    marl::lock lock(_mutex);
+    _condition.wait(lock, [this]() {
+        return _inFlight < _entries;
+    });
+    if (!push(operation)) {
+        delete operation;
+        return false;
+    }
+    ++_inFlight;
+    return true;
+}
+
+LinuxIoRing& LinuxIoRing::instance() {
+    static LinuxIoRing ring;
+    return ring;
+}
+
+bool LinuxIoRing::push(Operation* operation) noexcept {
+    // Without SQPOLL the kernel only consumes the submission queue inside io_uring_enter,
+    // which is always called under _mutex, so the tail can be rolled back on failure
+    const auto tail  = *_sqTail;
+    const auto index = tail & *_sqMask;
+
+    auto& sqe = _sqes[index];
+    memset(&sqe, 0, sizeof(sqe));
+    if (operation) {
+        const auto request = operation->request;
+        sqe.opcode         = IORING_OP_READV;
+        sqe.fd             = operation->fd;
+        sqe.off            = request->offset + request->bytesRead;
+        sqe.addr           = (gerium_uint64_t) &operation->iov;
+        sqe.len            = 1;
+    } else {
+        sqe.opcode = IORING_OP_NOP;
+    }
+    sqe.user_data = (gerium_uint64_t) operation;
+
+    _sqArray[index] = index;
+    std::atomic_ref(*_sqTail).store(tail + 1, std::memory_order_release);
+
+    // EAGAIN and EBUSY clear only once the completion thread drains the completion queue, and push may run on
+    // that very thread, so the retries are bounded instead of spinning under _mutex. A result of 0 means the
+    // entry was not consumed and is retried the same way
+    for (gerium_uint32_t attempt = 0; attempt < kMaxSubmitAttempts; ++attempt) {
+        const auto result = ioUringEnter(_ring, 1, 0, 0);
+        if (result > 0) {
+            return true;
+        }
+        if (result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            break;
+        }
+        if (result == 0 || errno != EINTR) {
+            std::this_thread::sleep_for(kSubmitBackoff * (attempt + 1));
+        }
+    }
+
+    std::atomic_ref(*_sqTail).store(tail, std::memory_order_release);
+    return false;
+}
+
+void LinuxIoRing::complete(Operation* operation, int result) noexcept {
+    auto request = operation->request;
+    if (result == -EINTR || result == -EAGAIN) {
+        result = 0;
+    } else if (result < 0) {
+        finish(operation, GERIUM_RESULT_ERROR_FILE_READ);
+        return;
+    } else if (result == 0) {
+        finish(operation, GERIUM_RESULT_SUCCESS);
+        return;
+    }
+
+    request->bytesRead += (gerium_uint32_t) result;
+    if (request->bytesRead == request->size) {
+        finish(operation, GERIUM_RESULT_SUCCESS);
+        return;
+    }
+
+    operation->iov.iov_base = (gerium_uint8_t*) request->data + request->bytesRead;
+    operation->iov.iov_len  = request->size - request->bytesRead;
+
+    bool pushed;
+    {
+        marl::lock lock(_mutex);
+        pushed = push(operation);
+    }
+    if (!pushed) {
+        finish(operation, GERIUM_RESULT_ERROR_FILE_READ);
+    }
+}
+
+void LinuxIoRing::finish(Operation* operation, gerium_result_t result) noexcept {
+    auto request = operation->request;
+    delete operation;
+    {
+        marl::lock lock(_mutex);
+        --_inFlight;
+    }
+    _condition.notify_one();
+    File::completeRead(request, result);
+}
+
+void LinuxIoRing::completionThread() noexcept {
+    while (true) {
+        if (ioUringEnter(_ring, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+            break;
+        }
+
+        auto head       = *_cqHead;
+        const auto tail = std::atomic_ref(*_cqTail).load(std::memory_order_acquire);
+
+        for (; head != tail; ++head) {
+            const auto& cqe = _cqes[head & *_cqMask];
+            auto operation  = (Operation*) cqe.user_data;
+            auto result     = cqe.res;
+            std::atomic_ref(*_cqHead).store(head + 1, std::memory_order_release);
+
+            if (operation) {
+                complete(operation, result);
+            } else {
+                marl::lock lock(_mutex);
+                --_inFlight;
+            }
+        }
+
+        marl::lock lock(_mutex);
+        if (_shutdown && _inFlight == 0) {
+            break;
+        }
+    }
+}
+
+} // namespace gerium::linux
@@ -0,0 +1,65 @@
+#ifndef GERIUM_LINUX_LINUX_IO_RING_HPP
+#define GERIUM_LINUX_LINUX_IO_RING_HPP
+
+#include "../File.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+namespace gerium::linux {
+
+class LinuxIoRing final {
+public:
+    explicit LinuxIoRing(gerium_uint32_t entries = 256);
+    ~LinuxIoRing();
+
+    LinuxIoRing(const LinuxIoRing&)            = delete;
+    LinuxIoRing& operator=(const LinuxIoRing&) = delete;
+
+    bool isSupported() const noexcept;
+
+    bool submit(int fd, FileReadRequest* request);
+
+    static LinuxIoRing& instance();
+
+private:
+    static constexpr gerium_uint32_t kMaxSubmitAttempts = 8;
+    static constexpr auto kSubmitBackoff                = std::chrono::microseconds(50);
+
+    struct Operation {
+        FileReadRequest* request;
+        int fd;
+        iovec iov;
+    };
+
+    bool push(Operation* operation) noexcept;
+    void complete(Operation* operation, int result) noexcept;
+    void finish(Operation* operation, gerium_result_t result) noexcept;
+    void completionThread() noexcept;
+
+    int _ring;
+    gerium_uint32_t _entries;
+    gerium_uint32_t _inFlight;
+    bool _shutdown;
+    void* _sqPtr;
+    size_t _sqSize;
+    void* _cqPtr;
+    size_t _cqSize;
+    io_uring_sqe* _sqes;
+    size_t _sqesSize;
+    unsigned* _sqHead;
+    unsigned* _sqTail;
+    unsigned* _sqMask;
+    unsigned* _sqArray;
+    unsigned* _cqHead;
+    unsigned* _cqTail;
+    unsigned* _cqMask;
+    io_uring_cqe* _cqes;
+    std::thread _thread;
+    marl::mutex _mutex;
+    marl::ConditionVariable _condition;
+};
+
+} // namespace gerium::linux
+
+#endif
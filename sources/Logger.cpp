@@ -58,20 +58,15 @@ void Logger::setLevel(gerium_utf8_t tag, gerium_logger_level_t level) noexcept {
 }
 
 void Logger::print(gerium_logger_level_t level, gerium_utf8_t message) noexcept {
-    if (level != GERIUM_LOGGER_LEVEL_OFF && level >= getLevelWithParent()) {
+    if (isPrintable(level)) {
         GERIUM_BEGIN_SAFE_BLOCK
             onPrint(_tag, level, message);
         GERIUM_END_SAFE_VOID_BLOCK
     }
 }
 
-void Logger::print(gerium_logger_level_t level, std::function<void(std::ostream&)>&& func) {
-    if (level != GERIUM_LOGGER_LEVEL_OFF && level >= getLevelWithParent()) {
-        std::ostringstream ss;
-        func(ss);
-        const auto message = ss.str();
-        print(level, message.c_str());
-    }
+bool Logger::isPrintable(gerium_logger_level_t level) noexcept {
+    return level != GERIUM_LOGGER_LEVEL_OFF && level >= getLevelWithParent();
 }
 
 ObjectPtr<Logger> Logger::create(gerium_utf8_t tag) {
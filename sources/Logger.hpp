@@ -21,7 +21,17 @@ public:
 
     void print(gerium_logger_level_t level, gerium_utf8_t message) noexcept;
 
-    void print(gerium_logger_level_t level, std::function<void(std::ostream&)> &&func);
+    template <typename Func>
+    requires std::is_invocable_v<Func, std::ostream&>
+    void print(gerium_logger_level_t level, Func&& func) {
+        // The message is only built when it is printed, a filtered out message costs no allocation
+        if (isPrintable(level)) {
+            std::ostringstream ss;
+            func(static_cast<std::ostream&>(ss));
+            const auto message = ss.str();
+            print(level, message.c_str());
+        }
+    }
 
     static ObjectPtr<Logger> create(gerium_utf8_t tag);
 
@@ -31,6 +41,8 @@ protected:
     static std::string_view levelToString(gerium_logger_level_t level) noexcept;
 
 private:
+    bool isPrintable(gerium_logger_level_t level) noexcept;
+
     static void validateTag(const std::string& tag);
     static void setLevel(gerium_uint64_t hash, gerium_logger_level_t level) noexcept;
     static std::vector<gerium_uint64_t> tagHashs(const std::string& tag);
@@ -1,4 +1,5 @@
 #include "MacOSFile.hpp"
+#include "../Archive.hpp"
 
 #include <mach-o/dyld.h>
 
@@ -97,7 +98,7 @@ gerium_utf8_t File::getAppDir() noexcept {
 }
 
 bool File::existsFile(gerium_utf8_t path) noexcept {
-    return macos::MacOSFile::exists(path, false) || macos::MacOSFile::resourceExists(path);
+    return Archive::exists(path) || macos::MacOSFile::exists(path, false) || macos::MacOSFile::resourceExists(path);
 }
 
 bool File::existsDir(gerium_utf8_t path) noexcept {
@@ -117,6 +118,11 @@ using namespace gerium;
 using namespace gerium::macos;
 
 gerium_result_t gerium_file_open(gerium_utf8_t path, gerium_bool_t read_only, gerium_file_t* file) {
+    if (read_only) {
+        if (auto result = Archive::open(path, file); result != GERIUM_RESULT_ERROR_NOT_FOUND) {
+            return result;
+        }
+    }
     return Object::create<MacOSFile>(*file, path, read_only != 0);
 }
 
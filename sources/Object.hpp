@@ -20,7 +20,7 @@ protected:
     static void error(gerium_result_t result);
 
 private:
-    gerium_sint32_t _refCount;
+    std::atomic<gerium_sint32_t> _refCount;
 };
 
 template <typename D, typename T, typename... Args>
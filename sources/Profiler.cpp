@@ -1,8 +1,16 @@
 #include "Profiler.hpp"
+#include "File.hpp"
 #include "Renderer.hpp"
+#include "StringPool.hpp"
 
 namespace gerium {
 
+Profiler::Profiler() : _logger(Logger::create("gerium:profiler")), _enabled(false), _traceCapturing(false) {
+    static std::atomic_uint64_t profilers;
+    _id = ++profilers;
+    _sortedSamples.reserve(_historySize);
+}
+
 void Profiler::getGpuTimestamps(gerium_uint32_t& gpuTimestampsCount,
                                 gerium_gpu_timestamp_t* gpuTimestamps) const noexcept {
     onGetGpuTimestamps(gpuTimestampsCount, gpuTimestamps);
@@ -12,6 +20,563 @@ gerium_uint32_t Profiler::getGpuTotalMemoryUsed() const noexcept {
     return onGetGpuTotalMemoryUsed();
 }
 
+bool Profiler::getPipelineStatisticsEnable() const noexcept {
+    return onGetPipelineStatisticsEnable();
+}
+
+void Profiler::setPipelineStatisticsEnable(bool enable) noexcept {
+    onSetPipelineStatisticsEnable(enable);
+}
+
+void Profiler::getPipelineStatistics(gerium_uint32_t& pipelineStatisticsCount,
+                                     gerium_pipeline_statistics_t* pipelineStatistics) const noexcept {
+    onGetPipelineStatistics(pipelineStatisticsCount, pipelineStatistics);
+}
+
+void Profiler::getMemoryStats(gerium_uint32_t& memoryStatsCount, gerium_memory_stats_t* memoryStats) const noexcept {
+    onGetMemoryStats(memoryStatsCount, memoryStats);
+}
+
+void Profiler::getAllocationStats(gerium_uint32_t& allocationStatsCount,
+                                  gerium_allocation_stats_t* allocationStats) const noexcept {
+    marl::lock lock(_allocationsMutex);
+    const auto count     = (gerium_uint32_t) kAllocationScopeCount;
+    allocationStatsCount = allocationStats ? std::min(allocationStatsCount, count) : count;
+    if (allocationStats) {
+        std::copy_n(_allocationStats, allocationStatsCount, allocationStats);
+    }
+}
+
+void Profiler::setHistorySize(gerium_uint32_t frames) {
+    if (frames == 0) {
+        error(GERIUM_RESULT_ERROR_INVALID_ARGUMENT);
+    }
+    marl::lock lock(_scopesMutex);
+    if (_historySize != frames) {
+        std::vector<gerium_float64_t> sortedSamples;
+        sortedSamples.reserve(frames);
+        _sortedSamples.swap(sortedSamples);
+        _historySize = frames;
+        for (auto& scope : _scopes) {
+            scope.samples.clear();
+            scope.samples.shrink_to_fit();
+            scope.next = 0;
+        }
+    }
+}
+
+gerium_uint32_t Profiler::getHistorySize() const noexcept {
+    marl::lock lock(_scopesMutex);
+    return _historySize;
+}
+
+void Profiler::getScopeStats(gerium_uint32_t& scopeStatsCount,
+                             gerium_profiler_scope_stats_t* scopeStats) const noexcept {
+    marl::lock lock(_scopesMutex);
+
+    if (!scopeStats) {
+        scopeStatsCount = (gerium_uint32_t) _scopes.size();
+        return;
+    }
+
+    const auto percentile = [this](gerium_float64_t p) {
+        // Nearest rank on the sorted window
+        const auto rank = (size_t) std::ceil(p * (gerium_float64_t) _sortedSamples.size());
+        return _sortedSamples[std::max(rank, size_t(1)) - 1];
+    };
+
+    scopeStatsCount = std::min(scopeStatsCount, (gerium_uint32_t) _scopes.size());
+    for (gerium_uint32_t i = 0; i < scopeStatsCount; ++i) {
+        const auto& scope = _scopes[i];
+        auto& stats       = scopeStats[i];
+
+        stats         = {};
+        stats.name    = scope.name;
+        stats.parent  = scope.parent;
+        stats.type    = scope.type;
+        stats.depth   = scope.depth;
+        stats.samples = (gerium_uint32_t) scope.samples.size();
+
+        if (scope.samples.empty()) {
+            continue;
+        }
+
+        _sortedSamples.assign(scope.samples.cbegin(), scope.samples.cend());
+        std::sort(_sortedSamples.begin(), _sortedSamples.end());
+
+        gerium_float64_t sum = 0.0;
+        for (auto sample : _sortedSamples) {
+            sum += sample;
+        }
+        const auto count = (gerium_float64_t) _sortedSamples.size();
+
+        gerium_float64_t variance = 0.0;
+        stats.mean                = sum / count;
+        for (auto sample : _sortedSamples) {
+            variance += (sample - stats.mean) * (sample - stats.mean);
+        }
+
+        stats.min     = _sortedSamples.front();
+        stats.max     = _sortedSamples.back();
+        stats.p50     = percentile(0.50);
+        stats.p95     = percentile(0.95);
+        stats.p99     = percentile(0.99);
+        stats.std_dev = std::sqrt(variance / count);
+    }
+}
+
+void Profiler::resetStats() noexcept {
+    marl::lock lock(_scopesMutex);
+    _scopes.clear();
+    _scopeIndices.clear();
+}
+
+void Profiler::setEnabled(bool enable) noexcept {
+    if (enable && !_enabled) {
+        // The time spent with the profiler disabled is not a frame
+        {
+            marl::lock lock(_hitchMutex);
+            _lastFrameTimestamp = 0;
+        }
+        marl::lock lock(_allocationsMutex);
+        readAllocationCounters(_allocationTotals);
+    }
+    _enabled = enable;
+}
+
+bool Profiler::isEnabled() const noexcept {
+    return _enabled;
+}
+
+void Profiler::pushCpu(gerium_utf8_t name) {
+    auto thread = cpuThread();
+    auto& stack = thread->stacks[marl::Scheduler::Fiber::current()];
+    if (stack.depth++ >= kMaxCpuDepth) {
+        return;
+    }
+
+    // A scope opened while the profiler is disabled is still tracked, so that the matching pop stays balanced
+    auto& event  = stack.open[stack.depth - 1];
+    event.name   = _enabled ? intern(name) : nullptr;
+    event.parent = stack.depth > 1 ? stack.open[stack.depth - 2].name : nullptr;
+    event.depth  = stack.depth - 1;
+    event.start  = event.name ? cpuTimestamp() : 0;
+}
+
+void Profiler::popCpu() noexcept {
+    auto thread = cpuThread();
+    auto it     = thread->stacks.find(marl::Scheduler::Fiber::current());
+    if (it == thread->stacks.end()) {
+        return;
+    }
+
+    const auto depth = --it->second.depth;
+    auto event       = depth < kMaxCpuDepth ? it->second.open[depth] : CpuEvent{};
+
+    // Fibers are pooled by marl, a stack is dropped as soon as its fiber leaves the outermost scope
+    if (!depth) {
+        thread->stacks.erase(it);
+    }
+    if (!event.name) {
+        return;
+    }
+    event.end = cpuTimestamp();
+
+    // The ring is read by collectCpuScopes, when it is full the scope is dropped rather than blocking the thread
+    const auto head = thread->head.load(std::memory_order_relaxed);
+    if (head - thread->tail.load(std::memory_order_acquire) < kCpuEventsPerThread) {
+        thread->events[head % kCpuEventsPerThread] = event;
+        thread->head.store(head + 1, std::memory_order_release);
+    }
+}
+
+void Profiler::endFrame() {
+    collectAllocations();
+
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_PROFILER);
+    collectRenderCounters();
+
+    const bool capturing = _traceCapturing;
+    {
+        marl::lock threadsLock(_cpuThreadsMutex);
+        marl::lock scopesLock(_scopesMutex);
+        marl::lock traceLock(_traceMutex);
+
+        for (auto& thread : _cpuThreads) {
+            const auto head = thread->head.load(std::memory_order_acquire);
+            auto tail       = thread->tail.load(std::memory_order_relaxed);
+            for (; tail != head; ++tail) {
+                const auto& event  = thread->events[tail % kCpuEventsPerThread];
+                const auto elapsed = (gerium_float64_t) (event.end - event.start) / 1000000.0;
+                recordSample(GERIUM_PROFILER_SCOPE_TYPE_CPU, event.name, event.parent, event.depth, elapsed);
+
+                if (capturing && event.start >= _traceStart) {
+                    _traceEvents.push_back({ event.name, event.start, event.end, thread->id, false, false });
+                }
+            }
+            thread->tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    if (capturing) {
+        marl::lock lock(_traceMutex);
+        if (--_traceFrames == 0) {
+            _traceCapturing = false;
+            try {
+                writeTrace();
+            } catch (...) {
+                // A trace that could not be written must not break the frame
+            }
+            _traceEvents.clear();
+            _traceEvents.shrink_to_fit();
+        }
+    }
+
+    detectHitch();
+    ++_frame;
+}
+
+void Profiler::setCounterNode(gerium_uint32_t node, gerium_utf8_t name) noexcept {
+    assert(node != kNoCounterNode && node <= kMaxCounterNodes);
+    _counterNodes[node].name = name;
+    _counterNodeCount        = std::max(_counterNodeCount, node);
+}
+
+void Profiler::addRenderCounters(gerium_uint32_t node, const gerium_render_counters_t& counters) noexcept {
+    // Recording threads only add to the slot of their node, the slots are drained when the frame ends
+    assert(node <= kMaxCounterNodes);
+    auto& values = _counterNodes[node].values;
+    for (size_t i = 0; i < kRenderCounterCount; ++i) {
+        if (const auto value = counters.*kRenderCounterFields[i]; value) {
+            values[i].fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Profiler::addRenderCounter(gerium_uint32_t node,
+                                gerium_uint64_t gerium_render_counters_t::*counter,
+                                gerium_uint64_t value) noexcept {
+    gerium_render_counters_t counters{};
+    counters.*counter = value;
+    addRenderCounters(node, counters);
+}
+
+void Profiler::getRenderCounters(gerium_render_counters_t& renderCounters) const noexcept {
+    marl::lock lock(_countersMutex);
+    renderCounters = _renderCounters;
+}
+
+void Profiler::getNodeRenderCounters(gerium_uint32_t& renderCountersCount,
+                                     gerium_render_counters_t* renderCounters) const noexcept {
+    marl::lock lock(_countersMutex);
+    const auto count    = (gerium_uint32_t) _nodeRenderCounters.size();
+    renderCountersCount = renderCounters ? std::min(renderCountersCount, count) : count;
+    if (renderCounters) {
+        std::copy_n(_nodeRenderCounters.cbegin(), renderCountersCount, renderCounters);
+    }
+}
+
+void Profiler::collectRenderCounters() {
+    marl::lock lock(_countersMutex);
+
+    _renderCounters       = {};
+    _renderCounters.name  = "frame";
+    _renderCounters.frame = _frame;
+    _nodeRenderCounters.clear();
+
+    for (gerium_uint32_t node = 0; node <= _counterNodeCount; ++node) {
+        gerium_render_counters_t counters{};
+        counters.name  = _counterNodes[node].name;
+        counters.frame = _frame;
+        for (size_t i = 0; i < kRenderCounterCount; ++i) {
+            const auto value = _counterNodes[node].values[i].exchange(0, std::memory_order_relaxed);
+            counters.*kRenderCounterFields[i] += value;
+            _renderCounters.*kRenderCounterFields[i] += value;
+        }
+        if (node != kNoCounterNode) {
+            _nodeRenderCounters.push_back(counters);
+        }
+    }
+
+    _counterNodeCount = 0;
+}
+
+void Profiler::collectAllocations() noexcept {
+    // The counters are totals since the start of the process, a frame is the difference between two reads
+    AllocationCounters totals[kAllocationScopeCount];
+    readAllocationCounters(totals);
+
+    marl::lock lock(_allocationsMutex);
+    for (size_t i = 0; i < kAllocationScopeCount; ++i) {
+        auto& stats           = _allocationStats[i];
+        const auto& previous  = _allocationTotals[i];
+        stats.scope           = gerium_allocation_scope_t(i);
+        stats.frame           = _frame;
+        stats.allocations     = totals[i].allocations - previous.allocations;
+        stats.frees           = totals[i].frees - previous.frees;
+        stats.allocated_bytes = totals[i].bytes - previous.bytes;
+        _allocationTotals[i]  = totals[i];
+    }
+}
+
+void Profiler::captureTrace(gerium_utf8_t filename, gerium_uint32_t frames) {
+    if (!filename || !frames) {
+        error(GERIUM_RESULT_ERROR_INVALID_ARGUMENT);
+    }
+    marl::lock lock(_traceMutex);
+    _tracePath      = filename;
+    _traceFrames    = frames;
+    _traceStart     = cpuTimestamp();
+    _traceCapturing = true;
+    _traceEvents.clear();
+}
+
+bool Profiler::isCapturingTrace() const noexcept {
+    return _traceCapturing;
+}
+
+void Profiler::traceInstant(gerium_utf8_t name) {
+    if (_traceCapturing) {
+        const auto thread    = cpuThread()->id;
+        const auto timestamp = cpuTimestamp();
+
+        marl::lock lock(_traceMutex);
+        _traceEvents.push_back({ intern(name), timestamp, timestamp, thread, false, true });
+    }
+}
+
+void Profiler::setHitchThreshold(gerium_float32_t threshold) {
+    if (!(threshold > 1.0f)) {
+        error(GERIUM_RESULT_ERROR_INVALID_ARGUMENT);
+    }
+    marl::lock lock(_hitchMutex);
+    _hitchThreshold = threshold;
+}
+
+gerium_float32_t Profiler::getHitchThreshold() const noexcept {
+    marl::lock lock(_hitchMutex);
+    return _hitchThreshold;
+}
+
+void Profiler::getHitches(gerium_uint32_t& hitchesCount, gerium_hitch_t* hitches) const noexcept {
+    marl::lock lock(_hitchMutex);
+    const auto count = (gerium_uint32_t) _hitches.size();
+    hitchesCount     = hitches ? std::min(hitchesCount, count) : count;
+    if (hitches) {
+        std::copy_n(_hitches.cbegin(), hitchesCount, hitches);
+    }
+}
+
+void Profiler::clearHitches() noexcept {
+    marl::lock lock(_hitchMutex);
+    _hitches.clear();
+}
+
+void Profiler::addHitchEvent(gerium_hitch_cause_t cause,
+                             gerium_utf8_t name,
+                             gerium_uint32_t count,
+                             gerium_float64_t elapsed) {
+    if (!_enabled) {
+        return;
+    }
+
+    marl::lock lock(_hitchMutex);
+    name = name ? intern(name) : nullptr;
+
+    // Repeated events of the same kind are folded, a frame that creates fifty pipelines reports one entry
+    for (auto& event : _hitchEvents) {
+        if (event.cause == cause && event.name == name) {
+            event.count += count;
+            event.elapsed += elapsed;
+            return;
+        }
+    }
+    _hitchEvents.push_back({ cause, name, count, elapsed });
+}
+
+void Profiler::detectHitch() {
+    static constexpr std::string_view causes[] = {
+        "pipeline creation",    "shader compile", "frame graph compile",   "frame graph resize",
+        "swapchain recreation", "large upload",   "descriptor allocation", "deletion burst"
+    };
+
+    const auto timestamp = cpuTimestamp();
+    const auto previous  = std::exchange(_lastFrameTimestamp, timestamp);
+
+    marl::lock lock(_hitchMutex);
+    if (!previous) {
+        _hitchEvents.clear();
+        return;
+    }
+
+    // The baseline is the median of the previous frames, so the hitch itself and the occasional slow frame
+    // do not move it. Nothing is reported until half of the window has been filled
+    const auto elapsed        = (gerium_float64_t) (timestamp - previous) / 1000000.0;
+    const auto count          = std::min(_frameTimeCount, kHitchBaselineFrames);
+    gerium_float64_t baseline = 0.0;
+    if (count >= kHitchBaselineFrames / 2) {
+        gerium_float64_t sorted[kHitchBaselineFrames];
+        std::copy_n(_frameTimes, count, sorted);
+        std::nth_element(sorted, sorted + count / 2, sorted + count);
+        baseline = sorted[count / 2];
+    }
+    _frameTimes[_frameTimeCount++ % kHitchBaselineFrames] = elapsed;
+
+    if (baseline > 0.0 && elapsed > baseline * _hitchThreshold && elapsed - baseline >= kMinHitchElapsed) {
+        std::sort(_hitchEvents.begin(), _hitchEvents.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.elapsed > rhs.elapsed;
+        });
+
+        gerium_hitch_t hitch{};
+        hitch.frame       = _frame;
+        hitch.elapsed     = elapsed;
+        hitch.baseline    = baseline;
+        hitch.event_count = (gerium_uint32_t) std::min(_hitchEvents.size(), std::size(hitch.events));
+        std::copy_n(_hitchEvents.cbegin(), hitch.event_count, hitch.events);
+
+        if (_hitches.size() == kMaxHitches) {
+            _hitches.erase(_hitches.begin());
+        }
+        _hitches.push_back(hitch);
+
+        _logger->print(GERIUM_LOGGER_LEVEL_WARNING, [&hitch](auto& stream) {
+            stream.precision(2);
+            stream << std::fixed << "Frame " << hitch.frame << " took " << hitch.elapsed << " ms, baseline "
+                   << hitch.baseline << " ms";
+            if (!hitch.event_count) {
+                stream << ", no expensive events recorded";
+            }
+            for (gerium_uint32_t i = 0; i < hitch.event_count; ++i) {
+                const auto& event = hitch.events[i];
+                stream << (i ? "; " : ": ") << causes[event.cause];
+                if (event.name) {
+                    stream << " '" << event.name << "'";
+                }
+                if (event.count > 1) {
+                    stream << " x" << event.count;
+                }
+                stream << " " << event.elapsed << " ms";
+            }
+        });
+    }
+    _hitchEvents.clear();
+}
+
+void Profiler::addGpuTrace(gerium_utf8_t name, gerium_uint64_t start, gerium_uint64_t end) {
+    marl::lock lock(_traceMutex);
+    if (_traceCapturing && end >= _traceStart) {
+        _traceEvents.push_back({ name, start, end, 0, true, false });
+    }
+}
+
+void Profiler::addSample(gerium_profiler_scope_type_t type,
+                         gerium_utf8_t name,
+                         gerium_utf8_t parent,
+                         gerium_uint32_t depth,
+                         gerium_float64_t elapsed) {
+    marl::lock lock(_scopesMutex);
+    recordSample(type, name, parent, depth, elapsed);
+}
+
+void Profiler::recordSample(gerium_profiler_scope_type_t type,
+                            gerium_utf8_t name,
+                            gerium_utf8_t parent,
+                            gerium_uint32_t depth,
+                            gerium_float64_t elapsed) {
+    // Names are interned, a scope is identified by its name and the name of its parent
+    struct {
+        gerium_utf8_t name;
+        gerium_utf8_t parent;
+        gerium_uint64_t type;
+    } key{ name, parent, (gerium_uint64_t) type };
+
+    const auto scopeKey = hash(key);
+
+    auto it = _scopeIndices.find(scopeKey);
+    if (it == _scopeIndices.end()) {
+        it = _scopeIndices.insert({ scopeKey, (gerium_uint32_t) _scopes.size() }).first;
+        _scopes.push_back({ name, parent, type, depth, 0, {} });
+    }
+
+    auto& scope = _scopes[it->second];
+    scope.depth = depth;
+    if (scope.samples.size() < _historySize) {
+        scope.samples.push_back(elapsed);
+    } else {
+        scope.samples[scope.next] = elapsed;
+    }
+    scope.next = (scope.next + 1) % _historySize;
+}
+
+Profiler::CpuThread* Profiler::cpuThread() {
+    thread_local gerium_uint64_t owner = 0;
+    thread_local CpuThread* thread     = nullptr;
+
+    if (owner != _id) {
+        marl::lock lock(_cpuThreadsMutex);
+        _cpuThreads.push_back(std::make_unique<CpuThread>());
+        thread     = _cpuThreads.back().get();
+        thread->id = (gerium_uint32_t) _cpuThreads.size() - 1;
+        owner      = _id;
+    }
+    return thread;
+}
+
+void Profiler::writeTrace() const {
+    // Chrome trace event format, it is opened by chrome://tracing and by the Perfetto UI. CPU threads go to
+    // process 1, GPU work to process 2; times are in microseconds from the start of the capture
+    const auto escape = [](gerium_utf8_t name) {
+        std::string result;
+        for (auto c = name; c && *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                result += '\\';
+            }
+            if ((unsigned char) *c >= 0x20) {
+                result += *c;
+            }
+        }
+        return result;
+    };
+
+    const auto time = [this](gerium_uint64_t timestamp) {
+        return timestamp > _traceStart ? (gerium_float64_t) (timestamp - _traceStart) / 1000.0 : 0.0;
+    };
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                       "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+                       "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+    char buffer[128];
+    for (const auto& event : _traceEvents) {
+        json += ",\n{\"name\":\"" + escape(event.name) + "\",";
+        if (event.instant) {
+            snprintf(buffer,
+                     sizeof(buffer),
+                     "\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                     event.thread,
+                     time(event.start));
+        } else {
+            snprintf(buffer,
+                     sizeof(buffer),
+                     "\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     event.gpu ? 2 : 1,
+                     event.thread,
+                     time(event.start),
+                     time(event.end) - time(event.start));
+        }
+        json += buffer;
+    }
+    json += "\n]}\n";
+
+    auto file = File::create(_tracePath.c_str(), (gerium_uint32_t) json.size());
+    memcpy(file->map(), json.data(), json.size());
+}
+
+gerium_uint64_t Profiler::cpuTimestamp() noexcept {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (gerium_uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
 } // namespace gerium
 
 using namespace gerium;
@@ -48,3 +613,133 @@ gerium_uint32_t gerium_profiler_get_gpu_total_memory_used(gerium_profiler_t prof
     assert(profiler);
     return alias_cast<Profiler*>(profiler)->getGpuTotalMemoryUsed();
 }
+
+gerium_result_t gerium_profiler_set_history_size(gerium_profiler_t profiler, gerium_uint32_t frames) {
+    assert(profiler);
+    GERIUM_ASSERT_ARG(frames > 0);
+
+    GERIUM_BEGIN_SAFE_BLOCK
+        alias_cast<Profiler*>(profiler)->setHistorySize(frames);
+    GERIUM_END_SAFE_BLOCK
+}
+
+gerium_uint32_t gerium_profiler_get_history_size(gerium_profiler_t profiler) {
+    assert(profiler);
+    return alias_cast<Profiler*>(profiler)->getHistorySize();
+}
+
+void gerium_profiler_get_scope_stats(gerium_profiler_t profiler,
+                                     gerium_uint32_t* scope_stats_count,
+                                     gerium_profiler_scope_stats_t* scope_stats) {
+    assert(profiler);
+    assert(scope_stats_count);
+    alias_cast<Profiler*>(profiler)->getScopeStats(*scope_stats_count, scope_stats);
+}
+
+void gerium_profiler_reset_stats(gerium_profiler_t profiler) {
+    assert(profiler);
+    alias_cast<Profiler*>(profiler)->resetStats();
+}
+
+void gerium_profiler_push_cpu(gerium_profiler_t profiler, gerium_utf8_t name) {
+    assert(profiler);
+    assert(name);
+    alias_cast<Profiler*>(profiler)->pushCpu(name);
+}
+
+void gerium_profiler_pop_cpu(gerium_profiler_t profiler) {
+    assert(profiler);
+    alias_cast<Profiler*>(profiler)->popCpu();
+}
+
+gerium_result_t gerium_profiler_capture_trace(gerium_profiler_t profiler,
+                                              gerium_utf8_t filename,
+                                              gerium_uint32_t frames) {
+    assert(profiler);
+    GERIUM_ASSERT_ARG(filename);
+    GERIUM_ASSERT_ARG(frames > 0);
+
+    GERIUM_BEGIN_SAFE_BLOCK
+        alias_cast<Profiler*>(profiler)->captureTrace(filename, frames);
+    GERIUM_END_SAFE_BLOCK
+}
+
+gerium_bool_t gerium_profiler_is_capturing_trace(gerium_profiler_t profiler) {
+    assert(profiler);
+    return alias_cast<Profiler*>(profiler)->isCapturingTrace();
+}
+
+gerium_bool_t gerium_profiler_get_pipeline_statistics_enable(gerium_profiler_t profiler) {
+    assert(profiler);
+    return alias_cast<Profiler*>(profiler)->getPipelineStatisticsEnable();
+}
+
+void gerium_profiler_set_pipeline_statistics_enable(gerium_profiler_t profiler, gerium_bool_t enable) {
+    assert(profiler);
+    alias_cast<Profiler*>(profiler)->setPipelineStatisticsEnable(enable);
+}
+
+void gerium_profiler_get_pipeline_statistics(gerium_profiler_t profiler,
+                                             gerium_uint32_t* pipeline_statistics_count,
+                                             gerium_pipeline_statistics_t* pipeline_statistics) {
+    assert(profiler);
+    assert(pipeline_statistics_count);
+    alias_cast<Profiler*>(profiler)->getPipelineStatistics(*pipeline_statistics_count, pipeline_statistics);
+}
+
+void gerium_profiler_get_memory_stats(gerium_profiler_t profiler,
+                                      gerium_uint32_t* memory_stats_count,
+                                      gerium_memory_stats_t* memory_stats) {
+    assert(profiler);
+    assert(memory_stats_count);
+    alias_cast<Profiler*>(profiler)->getMemoryStats(*memory_stats_count, memory_stats);
+}
+
+void gerium_profiler_get_render_counters(gerium_profiler_t profiler, gerium_render_counters_t* render_counters) {
+    assert(profiler);
+    assert(render_counters);
+    alias_cast<Profiler*>(profiler)->getRenderCounters(*render_counters);
+}
+
+void gerium_profiler_get_node_render_counters(gerium_profiler_t profiler,
+                                              gerium_uint32_t* render_counters_count,
+                                              gerium_render_counters_t* render_counters) {
+    assert(profiler);
+    assert(render_counters_count);
+    alias_cast<Profiler*>(profiler)->getNodeRenderCounters(*render_counters_count, render_counters);
+}
+
+gerium_result_t gerium_profiler_set_hitch_threshold(gerium_profiler_t profiler, gerium_float32_t threshold) {
+    assert(profiler);
+    GERIUM_ASSERT_ARG(threshold > 1.0f);
+
+    GERIUM_BEGIN_SAFE_BLOCK
+        alias_cast<Profiler*>(profiler)->setHitchThreshold(threshold);
+    GERIUM_END_SAFE_BLOCK
+}
+
+gerium_float32_t gerium_profiler_get_hitch_threshold(gerium_profiler_t profiler) {
+    assert(profiler);
+    return alias_cast<Profiler*>(profiler)->getHitchThreshold();
+}
+
+void gerium_profiler_get_hitches(gerium_profiler_t profiler,
+                                 gerium_uint32_t* hitches_count,
+                                 gerium_hitch_t* hitches) {
+    assert(profiler);
+    assert(hitches_count);
+    alias_cast<Profiler*>(profiler)->getHitches(*hitches_count, hitches);
+}
+
+void gerium_profiler_clear_hitches(gerium_profiler_t profiler) {
+    assert(profiler);
+    alias_cast<Profiler*>(profiler)->clearHitches();
+}
+
+void gerium_profiler_get_allocation_stats(gerium_profiler_t profiler,
+                                          gerium_uint32_t* allocation_stats_count,
+                                          gerium_allocation_stats_t* allocation_stats) {
+    assert(profiler);
+    assert(allocation_stats_count);
+    alias_cast<Profiler*>(profiler)->getAllocationStats(*allocation_stats_count, allocation_stats);
+}
@@ -1,6 +1,8 @@
 #ifndef GERIUM_PROFILER_HPP
 #define GERIUM_PROFILER_HPP
 
+#include "AllocationCounter.hpp"
+#include "Logger.hpp"
 #include "ObjectPtr.hpp"
 
 struct _gerium_profiler : public gerium::Object {};
@@ -9,15 +11,270 @@ namespace gerium {
 
 class Profiler : public _gerium_profiler {
 public:
+    // Counters recorded outside of frame graph nodes (uploads, dynamic buffers, ImGui) go to this slot
+    static constexpr gerium_uint32_t kNoCounterNode   = 0;
+    static constexpr gerium_uint32_t kMaxCounterNodes = 256;
+
+    Profiler();
+
     void getGpuTimestamps(gerium_uint32_t& gpuTimestampsCount, gerium_gpu_timestamp_t* gpuTimestamps) const noexcept;
 
     gerium_uint32_t getGpuTotalMemoryUsed() const noexcept;
 
+    bool getPipelineStatisticsEnable() const noexcept;
+    void setPipelineStatisticsEnable(bool enable) noexcept;
+    void getPipelineStatistics(gerium_uint32_t& pipelineStatisticsCount,
+                               gerium_pipeline_statistics_t* pipelineStatistics) const noexcept;
+
+    void getMemoryStats(gerium_uint32_t& memoryStatsCount, gerium_memory_stats_t* memoryStats) const noexcept;
+
+    void getAllocationStats(gerium_uint32_t& allocationStatsCount,
+                            gerium_allocation_stats_t* allocationStats) const noexcept;
+
+    void setHistorySize(gerium_uint32_t frames);
+    gerium_uint32_t getHistorySize() const noexcept;
+    void getScopeStats(gerium_uint32_t& scopeStatsCount, gerium_profiler_scope_stats_t* scopeStats) const noexcept;
+    void resetStats() noexcept;
+
+    void setEnabled(bool enable) noexcept;
+    bool isEnabled() const noexcept;
+
+    void pushCpu(gerium_utf8_t name);
+    void popCpu() noexcept;
+    void endFrame();
+
+    void setCounterNode(gerium_uint32_t node, gerium_utf8_t name) noexcept;
+    void addRenderCounters(gerium_uint32_t node, const gerium_render_counters_t& counters) noexcept;
+    void addRenderCounter(gerium_uint32_t node,
+                          gerium_uint64_t gerium_render_counters_t::*counter,
+                          gerium_uint64_t value) noexcept;
+    void getRenderCounters(gerium_render_counters_t& renderCounters) const noexcept;
+    void getNodeRenderCounters(gerium_uint32_t& renderCountersCount,
+                               gerium_render_counters_t* renderCounters) const noexcept;
+
+    void captureTrace(gerium_utf8_t filename, gerium_uint32_t frames);
+    bool isCapturingTrace() const noexcept;
+    void traceInstant(gerium_utf8_t name);
+
+    void setHitchThreshold(gerium_float32_t threshold);
+    gerium_float32_t getHitchThreshold() const noexcept;
+    void getHitches(gerium_uint32_t& hitchesCount, gerium_hitch_t* hitches) const noexcept;
+    void clearHitches() noexcept;
+    void addHitchEvent(gerium_hitch_cause_t cause,
+                       gerium_utf8_t name,
+                       gerium_uint32_t count,
+                       gerium_float64_t elapsed);
+
+    static gerium_uint64_t cpuTimestamp() noexcept;
+
+protected:
+    void addGpuTrace(gerium_utf8_t name, gerium_uint64_t start, gerium_uint64_t end);
+
+    void addSample(gerium_profiler_scope_type_t type,
+                   gerium_utf8_t name,
+                   gerium_utf8_t parent,
+                   gerium_uint32_t depth,
+                   gerium_float64_t elapsed);
+
 private:
+    struct Scope {
+        gerium_utf8_t name;
+        gerium_utf8_t parent;
+        gerium_profiler_scope_type_t type;
+        gerium_uint32_t depth;
+        gerium_uint32_t next;
+        std::vector<gerium_float64_t> samples;
+    };
+
+    struct CpuEvent {
+        gerium_utf8_t name;
+        gerium_utf8_t parent;
+        gerium_uint64_t start;
+        gerium_uint64_t end;
+        gerium_uint32_t depth;
+    };
+
+    struct TraceEvent {
+        gerium_utf8_t name;
+        gerium_uint64_t start;
+        gerium_uint64_t end;
+        gerium_uint32_t thread;
+        bool gpu;
+        bool instant;
+    };
+
+    static constexpr gerium_uint64_t gerium_render_counters_t::*kRenderCounterFields[] = {
+        &gerium_render_counters_t::draws,
+        &gerium_render_counters_t::dispatches,
+        &gerium_render_counters_t::mesh_task_launches,
+        &gerium_render_counters_t::indirect_calls,
+        &gerium_render_counters_t::pipeline_binds,
+        &gerium_render_counters_t::descriptor_set_binds,
+        &gerium_render_counters_t::descriptor_set_allocations,
+        &gerium_render_counters_t::barriers,
+        &gerium_render_counters_t::dynamic_buffer_bytes,
+        &gerium_render_counters_t::uploads
+    };
+
+    static constexpr auto kRenderCounterCount = std::size(kRenderCounterFields);
+
+    struct CounterNode {
+        gerium_utf8_t name;
+        std::atomic_uint64_t values[kRenderCounterCount];
+    };
+
+    static constexpr gerium_float32_t kDefaultHitchThreshold = 2.0f;
+    static constexpr gerium_float64_t kMinHitchElapsed       = 2.0;
+    static constexpr gerium_uint32_t kHitchBaselineFrames    = 60;
+    static constexpr gerium_uint32_t kMaxHitches             = 32;
+
+    static constexpr gerium_uint32_t kDefaultHistorySize = 120;
+    static constexpr gerium_uint32_t kMaxCpuDepth        = 32;
+    static constexpr gerium_uint32_t kCpuEventsPerThread = 4096;
+
+    struct CpuStack {
+        gerium_uint32_t depth;
+        CpuEvent open[kMaxCpuDepth];
+    };
+
+    struct CpuThread {
+        gerium_uint32_t id;
+        // Marl fibers may yield inside a scope and interleave on the same thread, each fiber keeps its own stack
+        absl::flat_hash_map<const marl::Scheduler::Fiber*, CpuStack> stacks;
+        CpuEvent events[kCpuEventsPerThread];
+        std::atomic_uint32_t head;
+        std::atomic_uint32_t tail;
+    };
+
     virtual void onGetGpuTimestamps(gerium_uint32_t& gpuTimestampsCount,
                                     gerium_gpu_timestamp_t* gpuTimestamps) const noexcept = 0;
 
     virtual gerium_uint32_t onGetGpuTotalMemoryUsed() const noexcept = 0;
+
+    virtual bool onGetPipelineStatisticsEnable() const noexcept      = 0;
+    virtual void onSetPipelineStatisticsEnable(bool enable) noexcept = 0;
+
+    virtual void onGetPipelineStatistics(gerium_uint32_t& pipelineStatisticsCount,
+                                         gerium_pipeline_statistics_t* pipelineStatistics) const noexcept = 0;
+
+    virtual void onGetMemoryStats(gerium_uint32_t& memoryStatsCount,
+                                  gerium_memory_stats_t* memoryStats) const noexcept = 0;
+
+    void recordSample(gerium_profiler_scope_type_t type,
+                      gerium_utf8_t name,
+                      gerium_utf8_t parent,
+                      gerium_uint32_t depth,
+                      gerium_float64_t elapsed);
+
+    CpuThread* cpuThread();
+
+    void writeTrace() const;
+
+    void collectRenderCounters();
+
+    void detectHitch();
+
+    void collectAllocations() noexcept;
+
+    ObjectPtr<Logger> _logger;
+    gerium_uint64_t _id;
+    gerium_uint32_t _frame{};
+    std::atomic_bool _enabled;
+
+    mutable marl::mutex _scopesMutex;
+    gerium_uint32_t _historySize{ kDefaultHistorySize };
+    std::vector<Scope> _scopes;
+    absl::flat_hash_map<gerium_uint64_t, gerium_uint32_t> _scopeIndices;
+    // Reserved for the whole history window, so the noexcept getScopeStats sorts samples without allocating
+    mutable std::vector<gerium_float64_t> _sortedSamples;
+
+    marl::mutex _cpuThreadsMutex;
+    std::vector<std::unique_ptr<CpuThread>> _cpuThreads;
+
+    CounterNode _counterNodes[kMaxCounterNodes + 1];
+    gerium_uint32_t _counterNodeCount{};
+    mutable marl::mutex _countersMutex;
+    gerium_render_counters_t _renderCounters{};
+    std::vector<gerium_render_counters_t> _nodeRenderCounters;
+
+    std::atomic_bool _traceCapturing;
+    marl::mutex _traceMutex;
+    std::string _tracePath;
+    gerium_uint32_t _traceFrames{};
+    gerium_uint64_t _traceStart{};
+    std::vector<TraceEvent> _traceEvents;
+
+    mutable marl::mutex _hitchMutex;
+    gerium_float32_t _hitchThreshold{ kDefaultHitchThreshold };
+    gerium_uint64_t _lastFrameTimestamp{};
+    gerium_uint32_t _frameTimeCount{};
+    gerium_float64_t _frameTimes[kHitchBaselineFrames]{};
+    std::vector<gerium_hitch_event_t> _hitchEvents;
+    std::vector<gerium_hitch_t> _hitches;
+
+    mutable marl::mutex _allocationsMutex;
+    AllocationCounters _allocationTotals[kAllocationScopeCount]{};
+    gerium_allocation_stats_t _allocationStats[kAllocationScopeCount]{};
+};
+
+class ProfilerScope final {
+public:
+    ProfilerScope(Profiler* profiler, gerium_utf8_t name) : _profiler(profiler) {
+        if (_profiler) {
+            _profiler->pushCpu(name);
+        }
+    }
+
+    ~ProfilerScope() {
+        if (_profiler) {
+            _profiler->popCpu();
+        }
+    }
+
+    ProfilerScope(const ProfilerScope&)            = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+private:
+    Profiler* _profiler;
+};
+
+class ProfilerEvent final {
+public:
+    ProfilerEvent(Profiler* profiler, gerium_hitch_cause_t cause, gerium_utf8_t name) :
+        _profiler(profiler && profiler->isEnabled() ? profiler : nullptr),
+        _cause(cause),
+        _name(name),
+        _count(1),
+        _start(_profiler ? Profiler::cpuTimestamp() : 0) {
+    }
+
+    ~ProfilerEvent() {
+        if (_profiler) {
+            const auto elapsed = (gerium_float64_t) (Profiler::cpuTimestamp() - _start) / 1000000.0;
+            try {
+                _profiler->addHitchEvent(_cause, _name, _count, elapsed);
+            } catch (...) {
+            }
+        }
+    }
+
+    void setCount(gerium_uint32_t count) noexcept {
+        _count = count;
+    }
+
+    void cancel() noexcept {
+        _profiler = nullptr;
+    }
+
+    ProfilerEvent(const ProfilerEvent&)            = delete;
+    ProfilerEvent& operator=(const ProfilerEvent&) = delete;
+
+private:
+    Profiler* _profiler;
+    gerium_hitch_cause_t _cause;
+    gerium_utf8_t _name;
+    gerium_uint32_t _count;
+    gerium_uint64_t _start;
 };
 
 } // namespace gerium
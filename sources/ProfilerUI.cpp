@@ -6,13 +6,12 @@
  */
 
 #include "ProfilerUI.hpp"
+#include "File.hpp"
 
 namespace gerium {
 
 void ProfilerUI::draw(Profiler* profiler, bool* show, uint32_t maxFrames) {
-    if (timestamps.empty()) {
-        timestamps.resize(maxFrames * 32);
-        colors.resize(maxFrames * 32);
+    if (perFrameActive.empty()) {
         perFrameActive.resize(maxFrames);
 
         maxDuration  = 8.0f;
@@ -29,14 +28,24 @@ void ProfilerUI::draw(Profiler* profiler, bool* show, uint32_t maxFrames) {
     }
 
     if (!paused) {
-        perFrameActive[currentFrame] = 32;
-        gerium_profiler_get_gpu_timestamps(profiler, &perFrameActive[currentFrame], &timestamps[currentFrame * 32]);
+        uint32_t count = 0;
+        gerium_profiler_get_gpu_timestamps(profiler, &count, nullptr);
+        if (count > timestampsPerFrame) {
+            // The history is laid out with a fixed stride per frame, so it starts over when the stride grows
+            timestampsPerFrame = count;
+            timestamps.assign(maxFrames * timestampsPerFrame, {});
+            colors.assign(maxFrames * timestampsPerFrame, 0);
+            std::fill(perFrameActive.begin(), perFrameActive.end(), 0);
+        }
+
+        auto* frameTimestamps        = timestamps.data() + currentFrame * timestampsPerFrame;
+        auto* frameColors            = colors.data() + currentFrame * timestampsPerFrame;
+        perFrameActive[currentFrame] = timestampsPerFrame;
+        gerium_profiler_get_gpu_timestamps(profiler, &perFrameActive[currentFrame], frameTimestamps);
         totalMemoryUsed = gerium_profiler_get_gpu_total_memory_used(profiler) / (1024 * 1024);
 
         for (uint32_t i = 0; i < perFrameActive[currentFrame]; ++i) {
-            auto& timestamp = timestamps[32 * currentFrame + i];
-
-            colors[32 * currentFrame + i] = nameColor(timestamp.name);
+            frameColors[i] = nameColor(frameTimestamps[i].name);
         }
 
         if (currentFrame == 0) {
@@ -108,9 +117,9 @@ void ProfilerUI::draw(Profiler* profiler, bool* show, uint32_t maxFrames) {
                 int32_t frame_index = (frame_pos) % maxFrames;
 
                 float frame_x          = cursor_pos.x + rect_x;
-                auto* frame_timestamps = &timestamps[frame_index * 32];
-                auto* frame_colors     = &colors[frame_index * 32];
-                float frame_time       = (float) frame_timestamps[0].elapsed;
+                auto* frame_timestamps = timestamps.data() + frame_index * timestampsPerFrame;
+                auto* frame_colors     = colors.data() + frame_index * timestampsPerFrame;
+                float frame_time       = perFrameActive[frame_index] ? (float) frame_timestamps[0].elapsed : 0.f;
                 // Clamp values to not destroy the frame data
                 frame_time = std::clamp(frame_time, 0.00001f, 1000.f);
                 // Update timings
@@ -176,8 +185,8 @@ void ProfilerUI::draw(Profiler* profiler, bool* show, uint32_t maxFrames) {
             int32_t frame_index = (frame_pos) % maxFrames;
             selected_frame      = selected_frame == -1 ? frame_index : selected_frame;
             if (selected_frame >= 0) {
-                auto* frame_timestamps = &timestamps[selected_frame * 32];
-                auto* frame_colors     = &colors[selected_frame * 32];
+                auto* frame_timestamps = timestamps.data() + selected_frame * timestampsPerFrame;
+                auto* frame_colors     = colors.data() + selected_frame * timestampsPerFrame;
 
                 float x = cursor_pos.x + graph_width;
                 float y = cursor_pos.y;
@@ -218,6 +227,22 @@ void ProfilerUI::draw(Profiler* profiler, bool* show, uint32_t maxFrames) {
 
         ImGui::Separator();
         ImGui::Checkbox("Pause", &paused);
+        ImGui::SameLine();
+        ImGui::Checkbox("Statistics", &showStats);
+        ImGui::SameLine();
+        ImGui::Checkbox("Memory", &showMemory);
+        ImGui::SameLine();
+        ImGui::Checkbox("Allocations", &showAllocations);
+        ImGui::SameLine();
+        if (gerium_profiler_is_capturing_trace(profiler)) {
+            ImGui::TextUnformatted("Capturing...");
+        } else if (ImGui::Button("Capture Trace (F12)") || ImGui::IsKeyPressed(ImGuiKey_F12, false)) {
+            tracePath = (std::filesystem::path(File::getCacheDir()) / "gerium-trace.json").string();
+            gerium_profiler_capture_trace(profiler, tracePath.c_str(), kTraceFrames);
+        }
+        if (!tracePath.empty()) {
+            ImGui::SetItemTooltip("%s", tracePath.c_str());
+        }
 
         static const char* items[]         = { "33ms", "16ms", "8ms", "4ms", "2ms" };
         static const float max_durations[] = { 33.f, 16.f, 8.f, 4.f, 2.f };
@@ -234,6 +259,196 @@ void ProfilerUI::draw(Profiler* profiler, bool* show, uint32_t maxFrames) {
 
     ImGui::End();
     ImGui::PopStyleVar();
+
+    if (showStats) {
+        drawStats(profiler);
+    }
+
+    if (showMemory) {
+        drawMemory(profiler);
+    }
+
+    if (showAllocations) {
+        drawAllocations(profiler);
+    }
+}
+
+void ProfilerUI::drawStats(Profiler* profiler) {
+    uint32_t count = 0;
+    gerium_profiler_get_scope_stats(profiler, &count, nullptr);
+    scopeStats.resize(count);
+    gerium_profiler_get_scope_stats(profiler, &count, scopeStats.data());
+
+    ImGui::SetNextWindowSize(ImVec2(640, 320), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Profiler Statistics", &showStats)) {
+        int history = (int) gerium_profiler_get_history_size(profiler);
+        ImGui::SetNextItemWidth(140.f);
+        if (ImGui::InputInt("History (frames)", &history) && history > 0) {
+            gerium_profiler_set_history_size(profiler, (gerium_uint32_t) history);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset")) {
+            gerium_profiler_reset_stats(profiler);
+        }
+        ImGui::SameLine();
+        bool pipelineStatistics = gerium_profiler_get_pipeline_statistics_enable(profiler);
+        if (ImGui::Checkbox("Pipeline Statistics", &pipelineStatistics)) {
+            gerium_profiler_set_pipeline_statistics_enable(profiler, pipelineStatistics);
+        }
+
+        constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+        const auto height    = pipelineStatistics ? ImGui::GetContentRegionAvail().y * 0.5f : 0.0f;
+        if (ImGui::BeginTable("scopes", 9, flags, ImVec2(0.0f, height))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+            for (auto column : { "Samples", "Mean", "P50", "P95", "P99", "Min", "Max", "StdDev" }) {
+                ImGui::TableSetupColumn(column, ImGuiTableColumnFlags_WidthFixed);
+            }
+            ImGui::TableHeadersRow();
+
+            for (const auto& stats : scopeStats) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%*s%s %s",
+                            int(stats.depth * 2),
+                            "",
+                            stats.type == GERIUM_PROFILER_SCOPE_TYPE_GPU ? "[GPU]" : "[CPU]",
+                            stats.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", stats.samples);
+                const gerium_float64_t values[] = { stats.mean, stats.p50, stats.p95, stats.p99,
+                                                    stats.min,  stats.max, stats.std_dev };
+                for (auto value : values) {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%2.4f", value);
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        if (pipelineStatistics) {
+            drawPipelineStatistics(profiler);
+        }
+    }
+    ImGui::End();
+}
+
+void ProfilerUI::drawPipelineStatistics(Profiler* profiler) {
+    uint32_t count = 0;
+    gerium_profiler_get_pipeline_statistics(profiler, &count, nullptr);
+    pipelineStatistics.resize(count);
+    gerium_profiler_get_pipeline_statistics(profiler, &count, pipelineStatistics.data());
+
+    constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("pipeline_statistics", 10, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Pass", ImGuiTableColumnFlags_WidthStretch);
+        for (auto column :
+             { "IA Vertices", "IA Primitives", "VS", "Clip In", "Clip Out", "FS", "CS", "Task", "Mesh" }) {
+            ImGui::TableSetupColumn(column, ImGuiTableColumnFlags_WidthFixed);
+        }
+        ImGui::TableHeadersRow();
+
+        for (const auto& statistics : pipelineStatistics) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(statistics.name);
+
+            const gerium_uint64_t values[] = { statistics.input_assembly_vertices,
+                                               statistics.input_assembly_primitives,
+                                               statistics.vertex_shader_invocations,
+                                               statistics.clipping_invocations,
+                                               statistics.clipping_primitives,
+                                               statistics.fragment_shader_invocations,
+                                               statistics.compute_shader_invocations,
+                                               statistics.task_shader_invocations,
+                                               statistics.mesh_shader_invocations };
+            for (auto value : values) {
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", (unsigned long long) value);
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void ProfilerUI::drawMemory(Profiler* profiler) {
+    uint32_t count = 0;
+    gerium_profiler_get_memory_stats(profiler, &count, nullptr);
+    memoryStats.resize(count);
+    gerium_profiler_get_memory_stats(profiler, &count, memoryStats.data());
+
+    static const char* names[] = { "Transient Targets", "Render Targets", "Textures", "Geometry", "Buffer Heap",
+                                   "Dynamic",           "Staging",        "Buffers",  "Recycled" };
+
+    constexpr auto toMB = 1.0 / (1024 * 1024);
+
+    ImGui::SetNextWindowSize(ImVec2(560, 260), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("GPU Memory", &showMemory)) {
+        constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("memory", 6, flags)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Category", ImGuiTableColumnFlags_WidthStretch);
+            for (auto column : { "Current MB", "Peak MB", "Allocations", "Peak Allocations", "Aliased MB" }) {
+                ImGui::TableSetupColumn(column, ImGuiTableColumnFlags_WidthFixed);
+            }
+            ImGui::TableHeadersRow();
+
+            for (const auto& stats : memoryStats) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(stats.category < std::size(names) ? names[stats.category] : "Unknown");
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.current_bytes * toMB);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.peak_bytes * toMB);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", stats.allocation_count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", stats.peak_allocation_count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.aliased_bytes * toMB);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+void ProfilerUI::drawAllocations(Profiler* profiler) {
+    uint32_t count = 0;
+    gerium_profiler_get_allocation_stats(profiler, &count, nullptr);
+    allocationStats.resize(count);
+    gerium_profiler_get_allocation_stats(profiler, &count, allocationStats.data());
+
+    static const char* names[] = { "Other", "Renderer", "Frame Graph", "Command Buffer", "Device", "Profiler" };
+
+    ImGui::SetNextWindowSize(ImVec2(460, 220), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Heap Allocations", &showAllocations)) {
+        constexpr auto flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("allocations", 4, flags)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+            for (auto column : { "Allocations", "Frees", "KB" }) {
+                ImGui::TableSetupColumn(column, ImGuiTableColumnFlags_WidthFixed);
+            }
+            ImGui::TableHeadersRow();
+
+            for (const auto& stats : allocationStats) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(stats.scope < std::size(names) ? names[stats.scope] : "Unknown");
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", (unsigned long long) stats.allocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", (unsigned long long) stats.frees);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.allocated_bytes / 1024.0);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
 }
 
 } // namespace gerium
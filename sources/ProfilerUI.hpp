@@ -10,10 +10,22 @@ public:
     void draw(Profiler* profiler, bool* show, uint32_t maxFrames);
 
 private:
+    static constexpr uint32_t kTraceFrames = 60;
+
+    void drawStats(Profiler* profiler);
+    void drawPipelineStatistics(Profiler* profiler);
+    void drawMemory(Profiler* profiler);
+    void drawAllocations(Profiler* profiler);
+
     std::vector<gerium_gpu_timestamp_t> timestamps;
     std::vector<uint32_t> colors;
     std::vector<uint32_t> perFrameActive;
+    std::vector<gerium_profiler_scope_stats_t> scopeStats;
+    std::vector<gerium_pipeline_statistics_t> pipelineStatistics;
+    std::vector<gerium_memory_stats_t> memoryStats;
+    std::vector<gerium_allocation_stats_t> allocationStats;
 
+    uint32_t timestampsPerFrame{};
     uint32_t currentFrame{};
 
     float maxTime{};
@@ -23,6 +35,11 @@ private:
     float maxDuration{};
     bool prevPaused{};
     bool paused{};
+    bool showStats{};
+    bool showMemory{};
+    bool showAllocations{};
+
+    std::string tracePath;
 
     //uint32_t initialFramesPaused = 3;
 
@@ -3,13 +3,40 @@
 
 namespace gerium {
 
-Renderer::Renderer() noexcept : _shutdownSignal(marl::Event::Mode::Manual), _waitTaskSignal(marl::Event::Mode::Manual) {
+Renderer::Renderer() noexcept :
+    _shutdownSignal(marl::Event::Mode::Manual),
+    _waitTaskSignal(marl::Event::Mode::Manual),
+    _decodeMemory(0),
+    _taskOrder(0),
+    _streamingFrame(0),
+    _streamingLoads(0),
+    _streamingRequested(false),
+    _evictionCallback(nullptr),
+    _evictionData(nullptr) {
+    for (auto& feedback : _streamingFeedback) {
+        feedback = Undefined;
+    }
 }
 
 Renderer::~Renderer() {
 }
 
-void Renderer::initialize(gerium_feature_flags_t features, gerium_uint32_t version, bool debug) {
+void Renderer::initialize(gerium_feature_flags_t features,
+                          gerium_uint32_t version,
+                          bool debug,
+                          const gerium_renderer_options_t* options) {
+    _options = options ? *options : gerium_renderer_options_t{};
+    if (!_options.upload_budget_bytes) {
+        _options.upload_budget_bytes = kUploadBudgetBytes;
+    }
+    if (!_options.upload_budget_copies) {
+        _options.upload_budget_copies = kUploadBudgetCopies;
+    }
+    if (!_options.frames_in_flight) {
+        _options.frames_in_flight = kFramesInFlight;
+    }
+    _options.frames_in_flight = std::clamp(_options.frames_in_flight, 2U, kStreamingFeedbackFrames);
+
     _logger     = Logger::create("gerium:renderer");
     _loadThread = std::thread([this, scheduler = marl::Scheduler::get()]() {
         scheduler->bind();
@@ -18,6 +45,19 @@ void Renderer::initialize(gerium_feature_flags_t features, gerium_uint32_t versi
     });
 
     onInitialize(features, version, debug);
+
+    if (_options.texture_streaming) {
+        for (auto& feedback : _streamingFeedback) {
+            BufferCreation bc;
+            bc.set(GERIUM_BUFFER_USAGE_STORAGE_BIT,
+                   ResourceUsageType::Readback,
+                   kMaxStreamedTextures * sizeof(gerium_sint32_t))
+                .setFillValue((gerium_uint32_t) kNoStreamingFeedback)
+                .setName("streaming_feedback")
+                .setPersistent(true);
+            feedback = createBuffer(bc);
+        }
+    }
 }
 
 gerium_feature_flags_t Renderer::getEnabledFeatures() const noexcept {
@@ -99,7 +139,7 @@ TextureHandle Renderer::asyncLoadTexture(gerium_utf8_t filename,
     constexpr char ktx2Identifier[] = { char(-85), 'K', 'T', 'X', ' ', '2', '0', char(-69), '\r', '\n', '\x1A', '\n' };
 
     if (memcmp(ktx2Identifier, fileData, std::size(ktx2Identifier)) == 0 && fileSize >= KTX_HEADER_SIZE) {
-        task = createLoadTaskKtx2(file, name);
+        task = createLoadTaskKtx2(file, name, _options.texture_streaming);
     } else {
         task = createLoadTask(file, name);
     }
@@ -107,11 +147,73 @@ TextureHandle Renderer::asyncLoadTexture(gerium_utf8_t filename,
     task->callback = callback;
     task->userData = data;
 
+    enqueueTask(task);
+    return task->texture;
+}
+
+bool Renderer::setLoadPriority(TextureHandle handle, gerium_float32_t priority) noexcept {
     marl::lock lock(_loadRequestsMutex);
-    _tasks.push(task);
-    _waitTaskSignal.signal();
+    if (auto it = _loadTasks.find(handle.index); it != _loadTasks.end()) {
+        it->second->priority = priority;
+        if (it->second->pending) {
+            // The heap is repaired right away, enqueueTask pushes onto it before the loader gets to run again.
+            // The loader is woken up as a raised priority can change what fits into the decode budget
+            std::make_heap(_pendingTasks.begin(), _pendingTasks.end(), compareTasks);
+            _waitTaskSignal.signal();
+        }
+        return true;
+    }
+    return false;
+}
 
-    return task->texture;
+bool Renderer::cancelLoad(TextureHandle handle) noexcept {
+    Task* task = nullptr;
+    {
+        marl::lock lock(_loadRequestsMutex);
+        auto it = _loadTasks.find(handle.index);
+        if (it == _loadTasks.end()) {
+            return false;
+        }
+        task            = it->second;
+        task->cancelled = true;
+        if (!task->pending) {
+            // Decoding or uploading is in progress, the task is discarded at the next step
+            return true;
+        }
+        _loadTasks.erase(it);
+        std::erase(_pendingTasks, task);
+        std::make_heap(_pendingTasks.begin(), _pendingTasks.end(), compareTasks);
+        if (task->streamTexture != Undefined) {
+            _streamedLoads.push_back({ task->streamTexture, task->texture, false });
+        }
+    }
+    freeTask(task);
+    return true;
+}
+
+void Renderer::getUploadStats(gerium_upload_stats_t& stats) noexcept {
+    stats = {};
+    {
+        marl::lock lock(_loadRequestsMutex);
+        stats.pending_textures = (gerium_uint32_t) _loadTasks.size();
+    }
+    onGetUploadStats(stats);
+}
+
+void Renderer::requestTextureMip(TextureHandle handle, gerium_uint8_t mip) noexcept {
+    if (auto it = _streamedTextures.find(handle.index); it != _streamedTextures.end()) {
+        it->second.requestedMip = std::min(it->second.requestedMip, mip);
+        _streamingRequested     = true;
+    }
+}
+
+BufferHandle Renderer::getStreamingFeedback() const noexcept {
+    return _streamingFeedback[_streamingFrame % kStreamingFeedbackFrames];
+}
+
+void Renderer::setEvictionCallback(gerium_eviction_func_t callback, gerium_data_t data) noexcept {
+    _evictionCallback = callback;
+    _evictionData     = data;
 }
 
 void Renderer::asyncUploadTextureData(TextureHandle handle,
@@ -121,7 +223,19 @@ void Renderer::asyncUploadTextureData(TextureHandle handle,
                                       gerium_cdata_t textureData,
                                       gerium_texture_loaded_func_t callback,
                                       gerium_data_t data) {
-    onAsyncUploadTextureData(handle, mip, generateMips, textureDataSize, textureData, callback, data);
+    onAsyncUploadTextureData(handle, mip, generateMips, textureDataSize, textureData, Undefined, 0, callback, data);
+}
+
+void Renderer::asyncUploadTextureBuffer(TextureHandle handle,
+                                        gerium_uint8_t mip,
+                                        bool generateMips,
+                                        gerium_uint32_t textureDataSize,
+                                        BufferHandle stagingBuffer,
+                                        gerium_uint32_t stagingOffset,
+                                        gerium_texture_loaded_func_t callback,
+                                        gerium_data_t data) {
+    onAsyncUploadTextureData(
+        handle, mip, generateMips, textureDataSize, nullptr, stagingBuffer, stagingOffset, callback, data);
 }
 
 void Renderer::textureSampler(TextureHandle handle,
@@ -148,6 +262,23 @@ void Renderer::destroyBuffer(BufferHandle handle) noexcept {
 }
 
 void Renderer::destroyTexture(TextureHandle handle) noexcept {
+    cancelLoad(handle);
+    if (auto it = _streamedTextures.find(handle.index); it != _streamedTextures.end()) {
+        // An unfinished stream-in texture is destroyed once its load is reported back, see updateStreaming
+        if (it->second.pending != Undefined) {
+            cancelLoad(it->second.pending);
+        }
+        _streamedTextures.erase(it);
+    }
+    {
+        // Mips of a load that is already decoding or uploading can still be queued for upload into the texture,
+        // so the texture outlives the task and is destroyed once the task is retired, see freeTask
+        marl::lock lock(_loadRequestsMutex);
+        if (auto it = _loadTasks.find(handle.index); it != _loadTasks.end()) {
+            it->second->destroyTexture = true;
+            return;
+        }
+    }
     onDestroyTexture(handle);
 }
 
@@ -194,14 +325,25 @@ void Renderer::unmapBuffer(BufferHandle handle) noexcept {
 }
 
 bool Renderer::newFrame() {
-    return onNewFrame();
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_RENDERER);
+
+    releaseLoadResources();
+    createStagingBuffers();
+    if (!onNewFrame()) {
+        return false;
+    }
+    updateStreaming();
+    updateResidency();
+    return true;
 }
 
 void Renderer::render(FrameGraph& frameGraph) {
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_RENDERER);
     onRender(frameGraph);
 }
 
 void Renderer::present() {
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_RENDERER);
     onPresent();
 }
 
@@ -235,22 +377,40 @@ void Renderer::getSwapchainSize(gerium_uint16_t& width, gerium_uint16_t& height)
     onGetSwapchainSize(width, height);
 }
 
+const gerium_renderer_options_t& Renderer::options() const noexcept {
+    return _options;
+}
+
 void Renderer::closeLoadThread() {
     _shutdownSignal.signal();
     _waitTaskSignal.signal();
     _loadThread.join();
+    _decodeGroup.wait();
 
     while (!_tasks.empty()) {
-        auto task = _tasks.front();
-        if (task->ktxTexture) {
-            ktxTexture_Destroy(ktxTexture(task->ktxTexture));
-        } else if (task->mips.size() && task->mips.back().imageMip == 0) {
-            stbi_image_free((void*) task->mips.back().imageData);
-        }
-        task->file = nullptr;
-        delete task;
+        freeTask(_tasks.front());
         _tasks.pop();
     }
+    for (auto task : _pendingTasks) {
+        freeTask(task);
+    }
+    for (auto task : _admittedStaging) {
+        freeTask(task);
+    }
+    _pendingTasks.clear();
+    _admittedStaging.clear();
+    _loadTasks.clear();
+
+    releaseLoadResources();
+
+    _streamedTextures.clear();
+    _streamedLoads.clear();
+    for (auto& feedback : _streamingFeedback) {
+        if (feedback != Undefined) {
+            destroyBuffer(feedback);
+            feedback = Undefined;
+        }
+    }
 }
 
 Renderer::Task* Renderer::createLoadTask(ObjectPtr<File> file, const std::string& name) {
@@ -258,7 +418,10 @@ Renderer::Task* Renderer::createLoadTask(ObjectPtr<File> file, const std::string
     auto fileData = file->map();
 
     int comp, width, height;
-    stbi_info_from_memory((const stbi_uc*) fileData, (int) fileSize, &width, &height, &comp);
+    if (!stbi_info_from_memory((const stbi_uc*) fileData, (int) fileSize, &width, &height, &comp)) {
+        _logger->print(GERIUM_LOGGER_LEVEL_ERROR, stbi_failure_reason());
+        error(GERIUM_RESULT_ERROR_LOAD_TEXTURE);
+    }
 
     auto mipLevels = calcMipLevels(width, height);
 
@@ -270,10 +433,16 @@ Renderer::Task* Renderer::createLoadTask(ObjectPtr<File> file, const std::string
 
     auto handle = createTexture(tc);
 
-    return new Task{ this, handle, file, fileData, nullptr, true };
+    auto task           = new Task{ this, handle, file, fileData, nullptr, true };
+    task->readFile      = fileSize <= std::numeric_limits<gerium_uint32_t>::max();
+    task->decodeSize    = gerium_uint64_t(width) * gerium_uint64_t(height) * 4 + (task->readFile ? fileSize : 0);
+    task->staging       = Undefined;
+    task->mipEnd        = (gerium_uint8_t) mipLevels;
+    task->streamTexture = Undefined;
+    return task;
 }
 
-Renderer::Task* Renderer::createLoadTaskKtx2(ObjectPtr<File> file, const std::string& name) {
+Renderer::Task* Renderer::createLoadTaskKtx2(ObjectPtr<File> file, const std::string& name, bool streaming) {
     auto fileSize = file->getSize();
     auto fileData = file->map();
 
@@ -336,24 +505,136 @@ Renderer::Task* Renderer::createLoadTaskKtx2(ObjectPtr<File> file, const std::st
 
     auto mips = texture->generateMipmaps ? calcMipLevels(texture->baseWidth, texture->baseHeight) : texture->numLevels;
 
+    // A streamed texture starts with its mip tail only, the rest is brought in by updateStreaming
+    gerium_uint8_t mipBase = 0;
+    if (streaming && type == GERIUM_TEXTURE_TYPE_2D && !texture->generateMipmaps && texture->numLayers == 1) {
+        while (mipBase + 1 < mips &&
+               std::max(texture->baseWidth >> mipBase, texture->baseHeight >> mipBase) > kStreamingTailSize) {
+            ++mipBase;
+        }
+    }
+
     TextureCreation tc{};
-    tc.setSize((gerium_uint16_t) texture->baseWidth,
-               (gerium_uint16_t) texture->baseHeight,
+    tc.setSize((gerium_uint16_t) std::max(texture->baseWidth >> mipBase, 1U),
+               (gerium_uint16_t) std::max(texture->baseHeight >> mipBase, 1U),
                (gerium_uint16_t) texture->baseDepth)
-        .setFlags(mips, 1, false, false)
+        .setFlags(mips - mipBase, 1, false, false)
         .setFormat(format, type)
         .setName(name.c_str());
 
     auto handle = createTexture(tc);
 
-    return new Task{ this, handle, file, fileData, texture, texture->generateMipmaps };
+    auto task           = new Task{ this, handle, file, fileData, texture, texture->generateMipmaps };
+    task->mipBase       = mipBase;
+    task->mipEnd        = (gerium_uint8_t) mips;
+    task->streamTexture = Undefined;
+    prepareKtx2Task(task);
+
+    if (mipBase) {
+        auto& streamed         = _streamedTextures[handle.index];
+        streamed.file          = file;
+        streamed.name          = name;
+        streamed.format        = format;
+        streamed.width         = (gerium_uint16_t) texture->baseWidth;
+        streamed.height        = (gerium_uint16_t) texture->baseHeight;
+        streamed.mipLevels     = (gerium_uint8_t) mips;
+        streamed.tailMip       = mipBase;
+        streamed.residentMip   = mipBase;
+        streamed.desiredMip    = 0;
+        streamed.requestedMip  = std::numeric_limits<gerium_uint8_t>::max();
+        streamed.lastRequest   = _streamingFrame;
+        streamed.residentBytes = onGetTextureMemory(handle);
+        streamed.pending       = Undefined;
+    }
+    return task;
+}
+
+Renderer::Task* Renderer::createStreamTask(TextureHandle handle, const StreamedTexture& texture, gerium_uint8_t mip) {
+    auto fileSize = texture.file->getSize();
+    auto fileData = texture.file->map();
+
+    ktxTexture2* ktx;
+    auto result =
+        ktxTexture2_CreateFromMemory((const ktx_uint8_t*) fileData, fileSize, KTX_TEXTURE_CREATE_NO_FLAGS, &ktx);
+    if (result != KTX_SUCCESS) {
+        _logger->print(GERIUM_LOGGER_LEVEL_ERROR, ktxErrorString(result));
+        error(GERIUM_RESULT_ERROR_LOAD_TEXTURE);
+    }
+
+    // The new texture holds the whole chain from the requested mip; resident mips are copied into it on the GPU,
+    // only the missing ones are decoded and uploaded
+    TextureCreation tc{};
+    tc.setSize((gerium_uint16_t) std::max(texture.width >> mip, 1),
+               (gerium_uint16_t) std::max(texture.height >> mip, 1),
+               1)
+        .setFlags(texture.mipLevels - mip, 1, false, false)
+        .setFormat(texture.format, GERIUM_TEXTURE_TYPE_2D)
+        .setName(texture.name.c_str());
+
+    auto load = createTexture(tc);
+
+    auto task           = new Task{ this, load, texture.file, fileData, ktx, false };
+    task->mipBase       = mip;
+    task->mipEnd        = texture.residentMip;
+    task->streamTexture = handle;
+    prepareKtx2Task(task);
+    return task;
+}
+
+void Renderer::prepareKtx2Task(Task* task) {
+    auto texture     = ktxTexture(task->ktxTexture);
+    task->decodeSize = ktxTexture_GetDataSizeUncompressed(texture);
+    task->staging    = Undefined;
+
+    if (!ktxTexture2_NeedsTranscoding(task->ktxTexture)) {
+        // The final size is known up front, so the image data is inflated by the decoder straight into
+        // mapped staging memory and copied to the texture from there. Only the selected mips are kept, and the
+        // buffer itself is created once the task is admitted for decoding, see createStagingBuffers
+        const auto levelEnd = std::min<ktx_uint32_t>(task->mipEnd, texture->numLevels);
+        if (task->mipBase != 0 || levelEnd < texture->numLevels) {
+            task->decodeSize = 0;
+            for (ktx_uint32_t level = task->mipBase; level < levelEnd; ++level) {
+                const auto depth    = std::max(texture->baseDepth >> level, 1U);
+                const auto faceSize = ktxTexture_GetImageSize(texture, level) * depth * texture->numLayers;
+                task->decodeSize += align((gerium_uint32_t) faceSize, 16) * texture->numFaces;
+            }
+        }
+        task->stagingSize = task->decodeSize;
+    }
+
+    // A load of the whole chain touches the whole file, so it is read into memory up front, see readTaskFile.
+    // Partial loads keep using the mapping and only fault in the pages of the levels they need
+    const auto fileSize = task->file->getSize();
+    if (task->mipBase == 0 && task->mipEnd >= texture->numLevels &&
+        fileSize <= std::numeric_limits<gerium_uint32_t>::max()) {
+        task->readFile = true;
+        task->decodeSize += fileSize;
+    }
+}
+
+void Renderer::enqueueTask(Task* task) {
+    task->pending = true;
+
+    marl::lock lock(_loadRequestsMutex);
+    task->order                     = _taskOrder++;
+    _loadTasks[task->texture.index] = task;
+    _pendingTasks.push_back(task);
+    std::push_heap(_pendingTasks.begin(), _pendingTasks.end(), compareTasks);
+    _waitTaskSignal.signal();
 }
 
 void Renderer::loadThread() noexcept {
     while (!_shutdownSignal.test()) {
         _waitTaskSignal.wait();
 
+        if (_shutdownSignal.test()) {
+            break;
+        }
+
+        ProfilerScope scope(getProfiler(), "load_thread");
+
         std::vector<Task*> tasks;
+        std::vector<Task*> decodes;
         {
             marl::lock lock(_loadRequestsMutex);
             tasks.reserve(_tasks.size());
@@ -361,77 +642,622 @@ void Renderer::loadThread() noexcept {
                 tasks.push_back(_tasks.front());
                 _tasks.pop();
             }
+            std::sort(tasks.begin(), tasks.end(), [](auto lhs, auto rhs) {
+                return compareTasks(rhs, lhs);
+            });
+
+            // Decoding is fanned out to marl workers, most important textures first; the amount of decoded data
+            // that has not been uploaded yet is bounded by kMaxDecodeMemory (a single texture larger than the
+            // budget is still allowed to go alone).
+            while (!_pendingTasks.empty()) {
+                auto task           = _pendingTasks.front();
+                const auto inFlight = _decodeMemory.load();
+                if (inFlight && inFlight + task->decodeSize > kMaxDecodeMemory) {
+                    break;
+                }
+                std::pop_heap(_pendingTasks.begin(), _pendingTasks.end(), compareTasks);
+                _pendingTasks.pop_back();
+                task->pending = false;
+                _decodeMemory += task->decodeSize;
+                if (task->stagingSize) {
+                    // Buffers are created on the render thread, the decode is scheduled from there
+                    _admittedStaging.push_back(task);
+                } else {
+                    decodes.push_back(task);
+                }
+            }
             _waitTaskSignal.clear();
         }
 
+        for (auto task : decodes) {
+            scheduleDecode(task);
+        }
+
         for (auto task : tasks) {
-            if (task->ktxTexture && task->mips.empty()) {
-                auto compressions = getTextureComperssion();
-                auto supportedASTC =
-                    (compressions & TextureCompressionFlags::ASTC_LDR) == TextureCompressionFlags::ASTC_LDR;
-                auto supportedETC2 = (compressions & TextureCompressionFlags::ETC2) == TextureCompressionFlags::ETC2;
-                auto supportedBC   = (compressions & TextureCompressionFlags::BC) == TextureCompressionFlags::BC;
-
-                if (ktxTexture2_NeedsTranscoding(task->ktxTexture)) {
-                    ktx_transcode_fmt_e tf;
-                    auto colorModel = ktxTexture2_GetColorModel_e(task->ktxTexture);
-                    if (colorModel == KHR_DF_MODEL_UASTC && supportedASTC) {
-                        tf = KTX_TTF_ASTC_4x4_RGBA;
-                    } else if (colorModel == KHR_DF_MODEL_ETC1S && supportedETC2) {
-                        tf = KTX_TTF_ETC;
-                    } else if (supportedASTC) {
-                        tf = KTX_TTF_ASTC_4x4_RGBA;
-                    } else if (supportedETC2) {
-                        tf = KTX_TTF_ETC2_RGBA;
-                    } else if (supportedBC) {
-                        tf = KTX_TTF_BC7_RGBA;
-                    }
-                    ktxTexture2_TranscodeBasis(task->ktxTexture, tf, 0);
-                }
+            if (task->result == GERIUM_RESULT_SUCCESS && !task->cancelled && task->mips.empty()) {
+                task->result = GERIUM_RESULT_ERROR_LOAD_TEXTURE;
+            }
+            if (task->cancelled || task->result != GERIUM_RESULT_SUCCESS) {
+                // Reported through the backend like a finished upload, so every callback runs on the render thread
+                onCompleteLoad(task->texture, task->result, uploadCompleted, task);
+            } else {
+                uploadTask(task);
+            }
+        }
+    }
+}
 
-                ktxTexture_IterateLevels(ktxTexture(task->ktxTexture), loadMips, &task->mips);
-            } else if (task->mips.empty()) {
-                int widht, height, comp;
-                auto imageData = (gerium_cdata_t) stbi_load_from_memory(
-                    (const stbi_uc*) task->data, (int) task->file->getSize(), &widht, &height, &comp, 4);
-                task->mips.push({ imageData, 0, 0 });
+void Renderer::createStagingBuffers() {
+    {
+        marl::lock lock(_loadRequestsMutex);
+        _allocatingStaging.swap(_admittedStaging);
+    }
+    for (auto task : _allocatingStaging) {
+        if (!task->cancelled) {
+            try {
+                BufferCreation bc;
+                bc.set({}, ResourceUsageType::Staging, (gerium_uint32_t) task->stagingSize)
+                    .setName("texture_staging")
+                    .setPersistent(true);
+                task->staging = createBuffer(bc);
+                task->stagingData =
+                    (gerium_uint8_t*) mapBuffer(task->staging, 0, (gerium_uint32_t) task->stagingSize);
+            } catch (...) {
+                task->result = GERIUM_RESULT_ERROR_OUT_OF_MEMORY;
             }
+        }
+        scheduleDecode(task);
+    }
+    _allocatingStaging.clear();
+}
 
-            if (_shutdownSignal.test()) {
-                break;
+void Renderer::scheduleDecode(Task* task) {
+    _decodeGroup.add();
+    marl::schedule([this, task]() {
+        defer(_decodeGroup.done());
+        if (!task->cancelled && task->result == GERIUM_RESULT_SUCCESS) {
+            ProfilerScope scope(getProfiler(), "decode_texture");
+            decodeTask(task);
+            selectMips(task);
+        }
+
+        marl::lock lock(_loadRequestsMutex);
+        _tasks.push(task);
+        _waitTaskSignal.signal();
+    });
+}
+
+bool Renderer::readTaskFile(Task* task) noexcept {
+    // A single asynchronous read: the worker fiber is suspended until it completes instead of blocking its thread
+    // on page faults in the mapping
+    struct Read {
+        marl::Event event;
+        gerium_result_t result;
+    };
+
+    const auto size = (gerium_uint32_t) task->file->getSize();
+    task->fileData.reset(new (std::nothrow) gerium_uint8_t[size]);
+    if (!task->fileData) {
+        task->result = GERIUM_RESULT_ERROR_OUT_OF_MEMORY;
+        return false;
+    }
+
+    constexpr auto completed = [](gerium_file_t file,
+                                  gerium_result_t result,
+                                  gerium_uint32_t bytesRead,
+                                  gerium_data_t data) {
+        auto read    = (Read*) data;
+        read->result = result;
+        read->event.signal();
+    };
+
+    Read read{ marl::Event(marl::Event::Mode::Manual), GERIUM_RESULT_SUCCESS };
+    try {
+        task->file->readAsync(0, task->fileData.get(), size, completed, nullptr, &read);
+    } catch (...) {
+        read.result = GERIUM_RESULT_ERROR_FILE_READ;
+        read.event.signal();
+    }
+    read.event.wait();
+
+    if (read.result != GERIUM_RESULT_SUCCESS) {
+        _logger->print(GERIUM_LOGGER_LEVEL_ERROR, "failed to read texture file");
+        task->result = read.result;
+        return false;
+    }
+    task->data = task->fileData.get();
+
+    if (task->ktxTexture) {
+        // The texture was opened on the mapping to read its header, image data now comes from the buffer
+        ktxTexture2* texture;
+        if (auto result =
+                ktxTexture2_CreateFromMemory(task->fileData.get(), size, KTX_TEXTURE_CREATE_NO_FLAGS, &texture);
+            result != KTX_SUCCESS) {
+            _logger->print(GERIUM_LOGGER_LEVEL_ERROR, ktxErrorString(result));
+            task->result = GERIUM_RESULT_ERROR_LOAD_TEXTURE;
+            return false;
+        }
+        ktxTexture_Destroy(ktxTexture(task->ktxTexture));
+        task->ktxTexture = texture;
+    }
+    return true;
+}
+
+void Renderer::decodeTask(Task* task) noexcept {
+    if (task->readFile && !readTaskFile(task)) {
+        return;
+    }
+
+    if (task->ktxTexture && task->staging != Undefined) {
+        // A part of the chain is inflated level by level and only the selected levels are packed into staging memory
+        auto texture          = ktxTexture(task->ktxTexture);
+        const auto wholeChain = task->mipBase == 0 && task->mipEnd >= texture->numLevels;
+        const auto result     = wholeChain ? ktxTexture_LoadImageData(texture, task->stagingData, task->stagingSize)
+                                           : ktxTexture_IterateLoadLevelFaces(texture, loadStagingMips, task);
+        unmapBuffer(task->staging);
+        if (result != KTX_SUCCESS) {
+            _logger->print(GERIUM_LOGGER_LEVEL_ERROR, ktxErrorString(result));
+            task->result = GERIUM_RESULT_ERROR_LOAD_TEXTURE;
+            return;
+        }
+        if (!wholeChain) {
+            return;
+        }
+
+        // Same order as ktxTexture_IterateLevels: from the smallest level to the base one
+        for (auto level = (int) texture->numLevels - 1; level >= 0; --level) {
+            const auto depth    = std::max(texture->baseDepth >> level, 1U);
+            const auto faceSize = ktxTexture_GetImageSize(texture, level) * depth * texture->numLayers;
+            for (ktx_uint32_t face = 0; face < texture->numFaces; ++face) {
+                ktx_size_t offset;
+                ktxTexture_GetImageOffset(texture, level, 0, face, &offset);
+                task->mips.push({ task->stagingData + offset,
+                                  (gerium_uint32_t) faceSize,
+                                  (gerium_uint8_t) level,
+                                  (gerium_uint32_t) offset });
+            }
+        }
+    } else if (task->ktxTexture) {
+        auto compressions  = getTextureComperssion();
+        auto supportedASTC = (compressions & TextureCompressionFlags::ASTC_LDR) == TextureCompressionFlags::ASTC_LDR;
+        auto supportedETC2 = (compressions & TextureCompressionFlags::ETC2) == TextureCompressionFlags::ETC2;
+        auto supportedBC   = (compressions & TextureCompressionFlags::BC) == TextureCompressionFlags::BC;
+
+        ktx_transcode_fmt_e tf = KTX_TTF_NOSELECTION;
+        auto needsTranscoding  = ktxTexture2_NeedsTranscoding(task->ktxTexture);
+        if (needsTranscoding) {
+            auto colorModel = ktxTexture2_GetColorModel_e(task->ktxTexture);
+            if (colorModel == KHR_DF_MODEL_UASTC && supportedASTC) {
+                tf = KTX_TTF_ASTC_4x4_RGBA;
+            } else if (colorModel == KHR_DF_MODEL_ETC1S && supportedETC2) {
+                tf = KTX_TTF_ETC;
+            } else if (supportedASTC) {
+                tf = KTX_TTF_ASTC_4x4_RGBA;
+            } else if (supportedETC2) {
+                tf = KTX_TTF_ETC2_RGBA;
+            } else if (supportedBC) {
+                tf = KTX_TTF_BC7_RGBA;
             }
+        }
 
-            const auto& taskMip = task->mips.front();
-
-            asyncUploadTextureData(task->texture,
-                                   taskMip.imageMip,
-                                   task->imageGenerateMips,
-                                   taskMip.imageSize,
-                                   taskMip.imageData,
-                                   [](auto _, auto texture, auto data) {
-                auto task = (Task*) data;
-                auto mip0 = task->mips.back();
-                task->mips.pop();
-                if (task->mips.empty()) {
-                    if (task->ktxTexture) {
-                        ktxTexture_Destroy(ktxTexture(task->ktxTexture));
-                    } else {
-                        stbi_image_free((void*) mip0.imageData);
-                    }
-                    task->file = nullptr;
-                    if (task->callback) {
-                        task->callback(task->renderer, task->texture, task->userData);
-                    }
-                    delete task;
-                } else {
-                    marl::lock lock(task->renderer->_loadRequestsMutex);
-                    task->renderer->_tasks.push(task);
-                    task->renderer->_waitTaskSignal.signal();
-                }
-            },
-                                   task);
+        if (loadCachedTask(task, (gerium_uint32_t) tf)) {
+            return;
+        }
+
+        if (needsTranscoding) {
+            if (auto result = ktxTexture2_TranscodeBasis(task->ktxTexture, tf, 0); result != KTX_SUCCESS) {
+                _logger->print(GERIUM_LOGGER_LEVEL_ERROR, ktxErrorString(result));
+                task->result = GERIUM_RESULT_ERROR_LOAD_TEXTURE;
+                return;
+            }
+        }
+
+        ktxTexture_IterateLevels(ktxTexture(task->ktxTexture), loadMips, &task->mips);
+        saveCachedTask(task);
+    } else {
+        if (loadCachedTask(task, (gerium_uint32_t) GERIUM_FORMAT_R8G8B8A8_UNORM)) {
+            return;
+        }
+
+        int widht, height, comp;
+        auto imageData = (gerium_cdata_t) stbi_load_from_memory(
+            (const stbi_uc*) task->data, (int) task->file->getSize(), &widht, &height, &comp, 4);
+        if (!imageData) {
+            _logger->print(GERIUM_LOGGER_LEVEL_ERROR, stbi_failure_reason());
+            task->result = GERIUM_RESULT_ERROR_LOAD_TEXTURE;
+            return;
+        }
+        task->mips.push({ imageData, (gerium_uint32_t) (widht * height * 4), 0, 0 });
+        saveCachedTask(task);
+    }
+}
+
+bool Renderer::loadCachedTask(Task* task, gerium_uint32_t format) noexcept {
+    if (_options.texture_cache_mode == GERIUM_TEXTURE_CACHE_MODE_DISABLED) {
+        return false;
+    }
+    try {
+        task->cache = std::make_unique<TextureCache>(
+            task->data, task->file->getSize(), format, (gerium_uint32_t) getTextureComperssion());
+    } catch (...) {
+        return false;
+    }
+    if (!task->cache->load()) {
+        return false;
+    }
+    for (const auto& mip : task->cache->mips()) {
+        task->mips.push({ mip.data, mip.size, mip.level, 0 });
+    }
+    task->cached = true;
+    return true;
+}
+
+void Renderer::saveCachedTask(Task* task) noexcept {
+    if (!task->cache) {
+        return;
+    }
+    std::vector<TextureCache::Mip> mips;
+    auto queue = task->mips;
+    while (!queue.empty()) {
+        const auto& mip = queue.front();
+        mips.push_back({ mip.imageData, mip.imageSize, mip.imageMip });
+        queue.pop();
+    }
+    task->cache->save(mips, _options.texture_cache_mode == GERIUM_TEXTURE_CACHE_MODE_COMPRESSED);
+    task->cache = nullptr;
+}
+
+void Renderer::uploadTask(Task* task) {
+    const auto& taskMip = task->mips.front();
+
+    if (task->staging != Undefined) {
+        asyncUploadTextureBuffer(task->texture,
+                                 taskMip.imageMip,
+                                 task->imageGenerateMips,
+                                 taskMip.imageSize,
+                                 task->staging,
+                                 taskMip.stagingOffset,
+                                 uploadCompleted,
+                                 task);
+    } else {
+        asyncUploadTextureData(task->texture,
+                               taskMip.imageMip,
+                               task->imageGenerateMips,
+                               taskMip.imageSize,
+                               taskMip.imageData,
+                               uploadCompleted,
+                               task);
+    }
+}
+
+void Renderer::uploadCompleted(gerium_renderer_t renderer,
+                               gerium_texture_h texture,
+                               gerium_result_t result,
+                               gerium_data_t data) {
+    auto task    = (Task*) data;
+    task->result = result;
+    if (task->mips.size() <= 1 || task->cancelled || result != GERIUM_RESULT_SUCCESS) {
+        finishTask(task);
+    } else {
+        task->mips.pop();
+        marl::lock lock(task->renderer->_loadRequestsMutex);
+        task->renderer->_tasks.push(task);
+        task->renderer->_waitTaskSignal.signal();
+    }
+}
+
+void Renderer::finishTask(Task* task) noexcept {
+    auto renderer = task->renderer;
+    if (task->callback && !task->cancelled) {
+        task->callback(renderer, task->texture, task->result, task->userData);
+    }
+    renderer->_decodeMemory -= task->decodeSize;
+    {
+        marl::lock lock(renderer->_loadRequestsMutex);
+        if (auto it = renderer->_loadTasks.find(task->texture.index);
+            it != renderer->_loadTasks.end() && it->second == task) {
+            renderer->_loadTasks.erase(it);
+        }
+        if (task->streamTexture != Undefined) {
+            renderer->_streamedLoads.push_back(
+                { task->streamTexture, task->texture, !task->cancelled && task->result == GERIUM_RESULT_SUCCESS });
+        }
+        renderer->_waitTaskSignal.signal();
+    }
+    freeTask(task);
+}
+
+bool Renderer::compareTasks(const Task* lhs, const Task* rhs) noexcept {
+    return lhs->priority != rhs->priority ? lhs->priority < rhs->priority : lhs->order > rhs->order;
+}
+
+void Renderer::freeTask(Task* task) noexcept {
+    if (task->staging != Undefined || task->destroyTexture) {
+        // Buffers and textures are destroyed on the render thread, see releaseLoadResources
+        marl::lock lock(task->renderer->_loadRequestsMutex);
+        if (task->staging != Undefined) {
+            task->renderer->_releasedStaging.push_back(task->staging);
+        }
+        if (task->destroyTexture) {
+            task->renderer->_releasedTextures.push_back(task->texture);
         }
     }
+    if (task->ktxTexture) {
+        ktxTexture_Destroy(ktxTexture(task->ktxTexture));
+    } else if (!task->cached && !task->mips.empty()) {
+        stbi_image_free((void*) task->mips.back().imageData);
+    }
+    task->cache = nullptr;
+    task->file  = nullptr;
+    delete task;
+}
+
+void Renderer::releaseLoadResources() noexcept {
+    // Each pair of lists is swapped back and forth, so both keep their capacity from frame to frame
+    {
+        marl::lock lock(_loadRequestsMutex);
+        _releasingStaging.swap(_releasedStaging);
+        _releasingTextures.swap(_releasedTextures);
+    }
+    for (auto buffer : _releasingStaging) {
+        destroyBuffer(buffer);
+    }
+    for (auto texture : _releasingTextures) {
+        onDestroyTexture(texture);
+    }
+    _releasingStaging.clear();
+    _releasingTextures.clear();
+}
+
+void Renderer::selectMips(Task* task) noexcept {
+    if (task->mipBase == 0 && task->mipEnd >= task->mips.size()) {
+        return;
+    }
+    std::queue<TaskMip> mips;
+    while (!task->mips.empty()) {
+        auto mip = task->mips.front();
+        if (mip.imageMip >= task->mipBase && mip.imageMip < task->mipEnd) {
+            mip.imageMip -= task->mipBase;
+            mips.push(mip);
+        }
+        task->mips.pop();
+    }
+    task->mips = std::move(mips);
+}
+
+bool Renderer::isLoading(TextureHandle handle) noexcept {
+    marl::lock lock(_loadRequestsMutex);
+    return _loadTasks.contains(handle.index);
+}
+
+void Renderer::updateStreaming() {
+    if (_streamingFeedback[0] == Undefined) {
+        return;
+    }
+    ++_streamingFrame;
+
+    {
+        marl::lock lock(_loadRequestsMutex);
+        _finishedStreamedLoads.swap(_streamedLoads);
+    }
+    for (const auto& [handle, load, success] : _finishedStreamedLoads) {
+        auto it = _streamedTextures.find(handle.index);
+        if (it != _streamedTextures.end() && it->second.pending == load) {
+            if (success) {
+                onSwapTextures(handle, load);
+                it->second.residentMip   = it->second.pendingMip;
+                it->second.residentBytes = onGetTextureMemory(handle);
+            }
+            it->second.pending = Undefined;
+        }
+        // After a swap this is the previous image of the streamed texture
+        onDestroyTexture(load);
+        --_streamingLoads;
+    }
+    _finishedStreamedLoads.clear();
+
+    readStreamingFeedback();
+
+    _streamIns.clear();
+    _streamOuts.clear();
+    gerium_uint64_t streamedBytes = 0;
+
+    for (auto& [index, texture] : _streamedTextures) {
+        if (texture.requestedMip != std::numeric_limits<gerium_uint8_t>::max()) {
+            texture.desiredMip   = std::min(texture.requestedMip, gerium_uint8_t(texture.mipLevels - 1));
+            texture.requestedMip = std::numeric_limits<gerium_uint8_t>::max();
+            texture.lastRequest  = _streamingFrame;
+        } else if (_streamingRequested && _streamingFrame - texture.lastRequest > kStreamingIdleFrames) {
+            texture.desiredMip = texture.tailMip;
+        }
+
+        streamedBytes += texture.residentBytes;
+        if (texture.pending != Undefined) {
+            continue;
+        }
+
+        const TextureHandle handle{ index };
+        if (texture.desiredMip < texture.residentMip) {
+            if (!isLoading(handle)) {
+                _streamIns.emplace_back(handle, &texture);
+            }
+        } else if (texture.desiredMip > texture.residentMip) {
+            _streamOuts.emplace_back(handle, &texture);
+        }
+    }
+
+    gerium_uint64_t limit, used;
+    if (_options.texture_streaming_budget) {
+        limit = _options.texture_streaming_budget;
+        used  = streamedBytes;
+    } else {
+        gerium_uint64_t budget;
+        onGetMemoryBudget(budget, used);
+        limit = gerium_uint64_t(budget * kStreamingBudgetRatio);
+    }
+
+    // Largest quality deficit first; textures nobody asked for the longest are the first to give mips back
+    std::sort(_streamIns.begin(), _streamIns.end(), [](const auto& lhs, const auto& rhs) {
+        const auto lhsDeficit = lhs.second->residentMip - lhs.second->desiredMip;
+        const auto rhsDeficit = rhs.second->residentMip - rhs.second->desiredMip;
+        return lhsDeficit != rhsDeficit ? lhsDeficit > rhsDeficit : lhs.second->lastRequest > rhs.second->lastRequest;
+    });
+    std::sort(_streamOuts.begin(), _streamOuts.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second->lastRequest < rhs.second->lastRequest;
+    });
+
+    auto streamOutIt = _streamOuts.begin();
+    auto evictNext   = [this, &streamOutIt, &used]() {
+        auto [handle, texture] = *streamOutIt++;
+        used -= std::min(used, streamOut(handle, *texture, texture->desiredMip));
+    };
+
+    while (used > limit && streamOutIt != _streamOuts.end()) {
+        evictNext();
+    }
+
+    for (auto [handle, texture] : _streamIns) {
+        if (_streamingLoads >= kMaxStreamingLoads) {
+            break;
+        }
+        const auto cost = estimateStreamedBytes(*texture, texture->desiredMip) - texture->residentBytes;
+        while (used + cost > limit && streamOutIt != _streamOuts.end()) {
+            evictNext();
+        }
+        if (used + cost > limit) {
+            break;
+        }
+        streamIn(handle, *texture, texture->desiredMip);
+        used += cost;
+    }
+
+    flushStreaming();
+}
+
+void Renderer::flushStreaming() {
+    if (!_streamingCopies.empty()) {
+        onCopyTextureMips((gerium_uint32_t) _streamingCopies.size(), _streamingCopies.data());
+        _streamingCopies.clear();
+    }
+    for (const auto& [handle, evicted] : _streamingSwaps) {
+        onSwapTextures(handle, evicted);
+        onDestroyTexture(evicted);
+        _streamedTextures[handle.index].residentBytes = onGetTextureMemory(handle);
+    }
+    _streamingSwaps.clear();
+}
+
+void Renderer::updateResidency() {
+    gerium_uint64_t budget, usage;
+    onGetMemoryBudget(budget, usage);
+    if (!budget || usage <= gerium_uint64_t(budget * kResidencyPressureRatio)) {
+        return;
+    }
+
+    // Evict down to a target below the pressure threshold so this does not kick in again every other frame
+    const auto target = gerium_uint64_t(budget * kResidencyTargetRatio);
+
+    _evictionCandidates.clear();
+    onGetEvictionCandidates(kResidencyIdleFrames, _evictionCandidates);
+
+    for (const auto& candidate : _evictionCandidates) {
+        if (usage <= target) {
+            break;
+        }
+        usage -= std::min(usage, evict(candidate));
+    }
+
+    flushStreaming();
+}
+
+gerium_uint64_t Renderer::evict(const gerium_eviction_t& candidate) {
+    if (candidate.type == GERIUM_RESOURCE_TYPE_TEXTURE) {
+        const TextureHandle handle{ candidate.texture.index };
+        if (isLoading(handle)) {
+            return 0;
+        }
+        // Streamed textures give their top mips back first, they come back once they are requested again
+        if (auto it = _streamedTextures.find(handle.index); it != _streamedTextures.end()) {
+            auto& texture = it->second;
+            if (texture.pending == Undefined && texture.residentMip < texture.tailMip) {
+                texture.desiredMip = texture.tailMip;
+                return streamOut(handle, texture, texture.tailMip);
+            }
+        }
+    }
+
+    if (_evictionCallback && _evictionCallback(this, &candidate, _evictionData)) {
+        return candidate.size;
+    }
+
+    if (candidate.type == GERIUM_RESOURCE_TYPE_BUFFER && onDemoteBuffer({ candidate.buffer.index })) {
+        return candidate.size;
+    }
+    return 0;
+}
+
+void Renderer::readStreamingFeedback() {
+    const auto feedback = _streamingFeedback[_streamingFrame % kStreamingFeedbackFrames];
+    const auto size     = kMaxStreamedTextures * (gerium_uint32_t) sizeof(gerium_sint32_t);
+    const auto data     = (gerium_sint32_t*) mapBuffer(feedback, 0, size);
+
+    for (auto& [index, texture] : _streamedTextures) {
+        if (index < kMaxStreamedTextures && data[index] != kNoStreamingFeedback) {
+            const auto mip       = std::clamp(texture.residentMip + data[index], 0, texture.mipLevels - 1);
+            texture.requestedMip = std::min(texture.requestedMip, (gerium_uint8_t) mip);
+            _streamingRequested  = true;
+        }
+    }
+
+    std::fill_n(data, kMaxStreamedTextures, kNoStreamingFeedback);
+    unmapBuffer(feedback);
+}
+
+void Renderer::streamIn(TextureHandle handle, StreamedTexture& texture, gerium_uint8_t mip) {
+    auto task = createStreamTask(handle, texture, mip);
+
+    _streamingCopies.push_back({ handle,
+                                 task->texture,
+                                 0,
+                                 gerium_uint8_t(texture.residentMip - mip),
+                                 gerium_uint8_t(texture.mipLevels - texture.residentMip) });
+
+    texture.pending    = task->texture;
+    texture.pendingMip = mip;
+    ++_streamingLoads;
+
+    enqueueTask(task);
+}
+
+gerium_uint64_t Renderer::streamOut(TextureHandle handle, StreamedTexture& texture, gerium_uint8_t mip) {
+    TextureCreation tc{};
+    tc.setSize((gerium_uint16_t) std::max(texture.width >> mip, 1),
+               (gerium_uint16_t) std::max(texture.height >> mip, 1),
+               1)
+        .setFlags(texture.mipLevels - mip, 1, false, false)
+        .setFormat(texture.format, GERIUM_TEXTURE_TYPE_2D)
+        .setName(texture.name.c_str());
+
+    auto evicted = createTexture(tc);
+
+    _streamingCopies.push_back({ handle,
+                                 evicted,
+                                 gerium_uint8_t(mip - texture.residentMip),
+                                 0,
+                                 gerium_uint8_t(texture.mipLevels - mip) });
+    _streamingSwaps.emplace_back(handle, evicted);
+
+    const auto freed = texture.residentBytes - std::min(texture.residentBytes, estimateStreamedBytes(texture, mip));
+    texture.residentMip = mip;
+    return freed;
+}
+
+gerium_uint64_t Renderer::estimateStreamedBytes(const StreamedTexture& texture, gerium_uint8_t mip) noexcept {
+    // Every mip level holds about a quarter of the previous one
+    if (mip < texture.residentMip) {
+        return texture.residentBytes << (2 * (texture.residentMip - mip));
+    }
+    return texture.residentBytes >> (2 * (mip - texture.residentMip));
 }
 
 KTX_error_code Renderer::loadMips(
@@ -441,6 +1267,25 @@ KTX_error_code Renderer::loadMips(
     return KTX_SUCCESS;
 }
 
+KTX_error_code Renderer::loadStagingMips(
+    int miplevel, int face, int width, int height, int depth, ktx_uint64_t faceLodSize, void* pixels, void* userdata) {
+    auto task = static_cast<Task*>(userdata);
+    if (miplevel < task->mipBase || miplevel >= task->mipEnd) {
+        return KTX_SUCCESS;
+    }
+    gerium_uint32_t offset = 0;
+    if (!task->mips.empty()) {
+        const auto& last = task->mips.back();
+        offset           = last.stagingOffset + align(last.imageSize, 16);
+    }
+    if (offset + faceLodSize > task->stagingSize) {
+        return KTX_FILE_DATA_ERROR;
+    }
+    memcpy(task->stagingData + offset, pixels, faceLodSize);
+    task->mips.push({ task->stagingData + offset, (gerium_uint32_t) faceLodSize, (gerium_uint8_t) miplevel, offset });
+    return KTX_SUCCESS;
+}
+
 } // namespace gerium
 
 using namespace gerium;
@@ -598,6 +1443,51 @@ gerium_result_t gerium_renderer_async_load_texture(gerium_renderer_t renderer,
     GERIUM_END_SAFE_BLOCK
 }
 
+gerium_result_t gerium_renderer_set_load_priority(gerium_renderer_t renderer,
+                                                  gerium_texture_h handle,
+                                                  gerium_float32_t priority) {
+    assert(renderer);
+    return alias_cast<Renderer*>(renderer)->setLoadPriority({ handle.index }, priority)
+               ? GERIUM_RESULT_SUCCESS
+               : GERIUM_RESULT_ERROR_NOT_FOUND;
+}
+
+gerium_result_t gerium_renderer_cancel_load(gerium_renderer_t renderer, gerium_texture_h handle) {
+    assert(renderer);
+    return alias_cast<Renderer*>(renderer)->cancelLoad({ handle.index }) ? GERIUM_RESULT_SUCCESS
+                                                                          : GERIUM_RESULT_ERROR_NOT_FOUND;
+}
+
+void gerium_renderer_get_upload_stats(gerium_renderer_t renderer, gerium_upload_stats_t* stats) {
+    assert(renderer);
+    assert(stats);
+    alias_cast<Renderer*>(renderer)->getUploadStats(*stats);
+}
+
+void gerium_renderer_request_texture_mip(gerium_renderer_t renderer, gerium_texture_h handle, gerium_uint8_t mip) {
+    assert(renderer);
+    alias_cast<Renderer*>(renderer)->requestTextureMip({ handle.index }, mip);
+}
+
+gerium_result_t gerium_renderer_get_streaming_feedback(gerium_renderer_t renderer, gerium_buffer_h* handle) {
+    assert(renderer);
+    GERIUM_ASSERT_ARG(handle);
+
+    auto feedback = alias_cast<Renderer*>(renderer)->getStreamingFeedback();
+    if (feedback == Undefined) {
+        return GERIUM_RESULT_ERROR_INVALID_OPERATION;
+    }
+    *handle = { feedback.index };
+    return GERIUM_RESULT_SUCCESS;
+}
+
+void gerium_renderer_set_eviction_callback(gerium_renderer_t renderer,
+                                           gerium_eviction_func_t callback,
+                                           gerium_data_t data) {
+    assert(renderer);
+    alias_cast<Renderer*>(renderer)->setEvictionCallback(callback, data);
+}
+
 gerium_result_t gerium_renderer_async_upload_texture_data(gerium_renderer_t renderer,
                                                           gerium_texture_h handle,
                                                           gerium_cdata_t texture_data,
@@ -4,6 +4,7 @@
 #include "Handles.hpp"
 #include "Logger.hpp"
 #include "Profiler.hpp"
+#include "TextureCache.hpp"
 
 struct _gerium_renderer : public gerium::Object {};
 
@@ -17,7 +18,10 @@ public:
     Renderer() noexcept;
     ~Renderer() override;
 
-    void initialize(gerium_feature_flags_t features, gerium_uint32_t version, bool debug);
+    void initialize(gerium_feature_flags_t features,
+                    gerium_uint32_t version,
+                    bool debug,
+                    const gerium_renderer_options_t* options);
 
     gerium_feature_flags_t getEnabledFeatures() const noexcept;
     TextureCompressionFlags getTextureComperssion() const noexcept;
@@ -42,6 +46,12 @@ public:
                                         gerium_uint32_t textureIndex);
 
     TextureHandle asyncLoadTexture(gerium_utf8_t filename, gerium_texture_loaded_func_t callback, gerium_data_t data);
+    bool setLoadPriority(TextureHandle handle, gerium_float32_t priority) noexcept;
+    bool cancelLoad(TextureHandle handle) noexcept;
+    void getUploadStats(gerium_upload_stats_t& stats) noexcept;
+    void requestTextureMip(TextureHandle handle, gerium_uint8_t mip) noexcept;
+    BufferHandle getStreamingFeedback() const noexcept;
+    void setEvictionCallback(gerium_eviction_func_t callback, gerium_data_t data) noexcept;
 
     void asyncUploadTextureData(TextureHandle handle,
                                 gerium_uint8_t mip,
@@ -51,6 +61,15 @@ public:
                                 gerium_texture_loaded_func_t callback,
                                 gerium_data_t data);
 
+    void asyncUploadTextureBuffer(TextureHandle handle,
+                                  gerium_uint8_t mip,
+                                  bool generateMips,
+                                  gerium_uint32_t textureDataSize,
+                                  BufferHandle stagingBuffer,
+                                  gerium_uint32_t stagingOffset,
+                                  gerium_texture_loaded_func_t callback,
+                                  gerium_data_t data);
+
     void textureSampler(TextureHandle handle,
                         gerium_filter_t minFilter,
                         gerium_filter_t magFilter,
@@ -96,15 +115,26 @@ public:
     void getSwapchainSize(gerium_uint16_t& width, gerium_uint16_t& height) const noexcept;
 
 protected:
+    struct TextureMipCopy {
+        TextureHandle src;
+        TextureHandle dst;
+        gerium_uint8_t srcMip;
+        gerium_uint8_t dstMip;
+        gerium_uint8_t mipCount;
+    };
+
     virtual void onInitialize(gerium_feature_flags_t features, gerium_uint32_t version, bool debug) = 0;
 
     void closeLoadThread();
 
+    const gerium_renderer_options_t& options() const noexcept;
+
 private:
     struct TaskMip {
         gerium_cdata_t imageData;
         gerium_uint32_t imageSize;
         gerium_uint8_t imageMip;
+        gerium_uint32_t stagingOffset;
     };
 
     struct Task {
@@ -117,8 +147,70 @@ private:
         std::queue<TaskMip> mips;
         gerium_texture_loaded_func_t callback;
         gerium_data_t userData;
+        gerium_result_t result;
+        gerium_uint64_t decodeSize;
+        bool pending;
+        gerium_float32_t priority;
+        gerium_uint64_t order;
+        std::atomic<bool> cancelled;
+        BufferHandle staging;
+        gerium_uint8_t* stagingData;
+        gerium_uint64_t stagingSize;
+        std::unique_ptr<TextureCache> cache;
+        bool cached;
+        gerium_uint8_t mipBase;
+        gerium_uint8_t mipEnd;
+        TextureHandle streamTexture;
+        bool destroyTexture;
+        bool readFile;
+        std::unique_ptr<gerium_uint8_t[]> fileData;
     };
 
+    struct StreamedTexture {
+        ObjectPtr<File> file;
+        std::string name;
+        gerium_format_t format;
+        gerium_uint16_t width;
+        gerium_uint16_t height;
+        gerium_uint8_t mipLevels;
+        gerium_uint8_t tailMip;
+        gerium_uint8_t residentMip;
+        gerium_uint8_t desiredMip;
+        gerium_uint8_t requestedMip;
+        gerium_uint64_t lastRequest;
+        gerium_uint64_t residentBytes;
+        TextureHandle pending;
+        gerium_uint8_t pendingMip;
+    };
+
+    struct StreamedLoad {
+        TextureHandle texture;
+        TextureHandle load;
+        bool success;
+    };
+
+    static constexpr gerium_uint64_t kMaxDecodeMemory    = 256 * 1024 * 1024;
+    static constexpr gerium_uint32_t kUploadBudgetBytes  = 32 * 1024 * 1024;
+    static constexpr gerium_uint32_t kUploadBudgetCopies = 64;
+    static constexpr gerium_uint32_t kFramesInFlight     = 2;
+
+    // Shaders report the mip they sample with atomicMin(feedback[texture.index], floor(textureQueryLod().y));
+    // the value is relative to the mips that were resident when the frame was recorded. A slot is read back
+    // kStreamingFeedbackFrames frames later, which has to be at least the number of frames in flight.
+    static constexpr gerium_uint32_t kStreamingFeedbackFrames = 4;
+    static constexpr gerium_uint32_t kMaxStreamedTextures     = 4096;
+    static constexpr gerium_sint32_t kNoStreamingFeedback     = std::numeric_limits<gerium_sint32_t>::max();
+    static constexpr gerium_uint16_t kStreamingTailSize       = 256;
+    static constexpr gerium_uint64_t kStreamingIdleFrames     = 300;
+    static constexpr gerium_uint32_t kMaxStreamingLoads       = 4;
+    static constexpr gerium_float32_t kStreamingBudgetRatio   = 0.8f;
+
+    // Residency kicks in above kResidencyPressureRatio of the device local budget and only touches resources that
+    // were not used for kResidencyIdleFrames frames
+    static constexpr gerium_float32_t kResidencyPressureRatio = 0.9f;
+    static constexpr gerium_float32_t kResidencyTargetRatio   = 0.85f;
+    static constexpr gerium_uint32_t kResidencyIdleFrames     = 120;
+
     virtual gerium_feature_flags_t onGetEnabledFeatures() const noexcept     = 0;
     virtual TextureCompressionFlags onGetTextureComperssion() const noexcept = 0;
 
@@ -146,9 +238,27 @@ private:
                                           bool generateMips,
                                           gerium_uint32_t textureDataSize,
                                           gerium_cdata_t textureData,
+                                          BufferHandle stagingBuffer,
+                                          gerium_uint32_t stagingOffset,
                                           gerium_texture_loaded_func_t callback,
                                           gerium_data_t data) = 0;
 
+    virtual void onCompleteLoad(TextureHandle handle,
+                                gerium_result_t result,
+                                gerium_texture_loaded_func_t callback,
+                                gerium_data_t data) = 0;
+
+    virtual void onGetUploadStats(gerium_upload_stats_t& stats) const noexcept = 0;
+
+    virtual void onCopyTextureMips(gerium_uint32_t count, const TextureMipCopy* copies)      = 0;
+    virtual void onSwapTextures(TextureHandle lhs, TextureHandle rhs) noexcept               = 0;
+    virtual void onGetMemoryBudget(gerium_uint64_t& budget, gerium_uint64_t& usage) noexcept = 0;
+    virtual gerium_uint64_t onGetTextureMemory(TextureHandle handle) const noexcept          = 0;
+
+    virtual void onGetEvictionCandidates(gerium_uint32_t minIdleFrames,
+                                         std::vector<gerium_eviction_t>& candidates) = 0;
+    virtual bool onDemoteBuffer(BufferHandle handle)                                 = 0;
+
     virtual void onTextureSampler(TextureHandle handle,
                                   gerium_filter_t minFilter,
                                   gerium_filter_t magFilter,
@@ -197,9 +307,39 @@ private:
     virtual void onGetSwapchainSize(gerium_uint16_t& width, gerium_uint16_t& height) const noexcept = 0;
 
     Task* createLoadTask(ObjectPtr<File> file, const std::string& name);
-    Task* createLoadTaskKtx2(ObjectPtr<File> file, const std::string& name);
+    Task* createLoadTaskKtx2(ObjectPtr<File> file, const std::string& name, bool streaming);
+    Task* createStreamTask(TextureHandle handle, const StreamedTexture& texture, gerium_uint8_t mip);
+    void prepareKtx2Task(Task* task);
+    void enqueueTask(Task* task);
+    void createStagingBuffers();
+    void scheduleDecode(Task* task);
 
     void loadThread() noexcept;
+    bool readTaskFile(Task* task) noexcept;
+    void decodeTask(Task* task) noexcept;
+    bool loadCachedTask(Task* task, gerium_uint32_t format) noexcept;
+    void saveCachedTask(Task* task) noexcept;
+    void uploadTask(Task* task);
+    static void uploadCompleted(gerium_renderer_t renderer,
+                                gerium_texture_h texture,
+                                gerium_result_t result,
+                                gerium_data_t data);
+    static void finishTask(Task* task) noexcept;
+    static bool compareTasks(const Task* lhs, const Task* rhs) noexcept;
+    static void freeTask(Task* task) noexcept;
+    void releaseLoadResources() noexcept;
+    static void selectMips(Task* task) noexcept;
+
+    bool isLoading(TextureHandle handle) noexcept;
+    void updateStreaming();
+    void readStreamingFeedback();
+    void streamIn(TextureHandle handle, StreamedTexture& texture, gerium_uint8_t mip);
+    gerium_uint64_t streamOut(TextureHandle handle, StreamedTexture& texture, gerium_uint8_t mip);
+    static gerium_uint64_t estimateStreamedBytes(const StreamedTexture& texture, gerium_uint8_t mip) noexcept;
+    void flushStreaming();
+
+    void updateResidency();
+    gerium_uint64_t evict(const gerium_eviction_t& candidate);
 
     static KTX_error_code loadMips(int miplevel,
                                    int face,
@@ -209,13 +349,47 @@ private:
                                    ktx_uint64_t faceLodSize,
                                    void* pixels,
                                    void* userdata);
+    static KTX_error_code loadStagingMips(int miplevel,
+                                          int face,
+                                          int width,
+                                          int height,
+                                          int depth,
+                                          ktx_uint64_t faceLodSize,
+                                          void* pixels,
+                                          void* userdata);
 
     ObjectPtr<Logger> _logger;
+    gerium_renderer_options_t _options;
     std::thread _loadThread;
     marl::Event _shutdownSignal;
     marl::Event _waitTaskSignal;
     marl::mutex _loadRequestsMutex;
     std::queue<Task*> _tasks;
+    std::vector<Task*> _pendingTasks;
+    gerium_uint64_t _taskOrder;
+    absl::flat_hash_map<gerium_uint16_t, Task*> _loadTasks;
+    std::vector<Task*> _admittedStaging;
+    std::vector<Task*> _allocatingStaging;
+    std::vector<BufferHandle> _releasedStaging;
+    std::vector<BufferHandle> _releasingStaging;
+    std::vector<TextureHandle> _releasedTextures;
+    std::vector<TextureHandle> _releasingTextures;
+    std::atomic<gerium_uint64_t> _decodeMemory;
+    marl::WaitGroup _decodeGroup;
+    absl::flat_hash_map<gerium_uint16_t, StreamedTexture> _streamedTextures;
+    std::vector<StreamedLoad> _streamedLoads;
+    std::vector<StreamedLoad> _finishedStreamedLoads;
+    std::vector<std::pair<TextureHandle, StreamedTexture*>> _streamIns;
+    std::vector<std::pair<TextureHandle, StreamedTexture*>> _streamOuts;
+    std::vector<TextureMipCopy> _streamingCopies;
+    std::vector<std::pair<TextureHandle, TextureHandle>> _streamingSwaps;
+    BufferHandle _streamingFeedback[kStreamingFeedbackFrames];
+    gerium_uint64_t _streamingFrame;
+    gerium_uint32_t _streamingLoads;
+    bool _streamingRequested;
+    gerium_eviction_func_t _evictionCallback;
+    gerium_data_t _evictionData;
+    std::vector<gerium_eviction_t> _evictionCandidates;
 };
 
 } // namespace gerium
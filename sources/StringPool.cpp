@@ -2,13 +2,17 @@
 
 namespace gerium {
 
+// Names are interned from the loader, decode workers, render workers and the upload thread as well
+static marl::mutex poolMutex;
 static StringPool pool;
 
 gerium_utf8_t intern(const char* str) {
+    marl::lock lock(poolMutex);
     return pool.intern(str);
 }
 
 gerium_utf8_t intern(std::string_view str) {
+    marl::lock lock(poolMutex);
     return pool.intern(str);
 }
 
@@ -0,0 +1,181 @@
+#include "TextureCache.hpp"
+#include "ArchiveFormat.hpp"
+
+namespace gerium {
+
+/**
+ * Cache format:
+ *
+ * uint32 - magic
+ * uint32 - version
+ * uint64 - key
+ * uint32 - mip count
+ * uint32 - compression (0 - none, 1 - zstd)
+ * uint32 - payload size
+ * uint32 - stored payload size
+ * [
+ *     uint32 - mip size
+ *     uint32 - mip level
+ * ]
+ * [...]  - payload, mips in upload order
+ **/
+
+TextureCache::TextureCache(gerium_cdata_t source,
+                           gerium_uint64_t sourceSize,
+                           gerium_uint32_t format,
+                           gerium_uint32_t device) {
+    struct {
+        gerium_uint32_t version;
+        gerium_uint32_t format;
+        gerium_uint32_t device;
+    } seed{ kVersion, format, device };
+
+    _key = wyhash(source, sourceSize, hash(seed), _wyp);
+
+    const auto filename = "texture-" + std::to_string(_key) + ".cache";
+    _path               = (std::filesystem::path(File::getCacheDir()) / filename).string();
+}
+
+bool TextureCache::load() noexcept {
+    try {
+        if (!File::existsFile(_path.c_str())) {
+            return false;
+        }
+
+        auto file           = File::open(_path.c_str(), true);
+        const auto fileSize = file->getSize();
+        const auto data     = (const gerium_uint8_t*) file->map();
+
+        if (fileSize < sizeof(Header)) {
+            return false;
+        }
+
+        const auto header = (const Header*) data;
+        if (header->magic != kMagic || header->version != kVersion || header->key != _key) {
+            return false;
+        }
+
+        const auto entriesSize = gerium_uint64_t(sizeof(Entry)) * header->mipCount;
+        if (fileSize != sizeof(Header) + entriesSize + header->storedSize) {
+            return false;
+        }
+
+        const auto entries = (const Entry*) (data + sizeof(Header));
+        auto payload       = data + sizeof(Header) + entriesSize;
+
+        switch ((archive::Compression) header->compression) {
+            case archive::Compression::None:
+                if (header->storedSize != header->size) {
+                    return false;
+                }
+                _file = std::move(file);
+                break;
+            case archive::Compression::Zstd: {
+                _buffer          = std::make_unique<gerium_uint8_t[]>(header->size);
+                const auto bytes = ZSTD_decompress(_buffer.get(), header->size, payload, header->storedSize);
+                if (ZSTD_isError(bytes) || bytes != header->size) {
+                    _buffer = nullptr;
+                    return false;
+                }
+                payload = _buffer.get();
+                break;
+            }
+            default:
+                return false;
+        }
+
+        gerium_uint64_t offset = 0;
+        _mips.reserve(header->mipCount);
+        for (gerium_uint32_t i = 0; i < header->mipCount; ++i) {
+            if (offset + entries[i].size > header->size) {
+                _mips.clear();
+                _file   = nullptr;
+                _buffer = nullptr;
+                return false;
+            }
+            _mips.push_back({ payload + offset, entries[i].size, (gerium_uint8_t) entries[i].level });
+            offset += entries[i].size;
+        }
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void TextureCache::save(const std::vector<Mip>& mips, bool compress) noexcept {
+    static std::atomic_uint32_t counter;
+
+    // The file is written under a unique name and then renamed, so a reader never sees a partially written
+    // cache and two workers decoding the same source do not write to the same file
+    const auto tempPath = _path + "." + std::to_string(counter++) + ".tmp";
+
+    try {
+        gerium_uint64_t size = 0;
+        for (const auto& mip : mips) {
+            size += mip.size;
+        }
+        if (size > std::numeric_limits<gerium_uint32_t>::max()) {
+            return;
+        }
+
+        auto payload = std::make_unique<gerium_uint8_t[]>(size);
+        auto dst     = payload.get();
+        for (const auto& mip : mips) {
+            memcpy(dst, mip.data, mip.size);
+            dst += mip.size;
+        }
+
+        Header header{};
+        header.magic       = kMagic;
+        header.version     = kVersion;
+        header.key         = _key;
+        header.mipCount    = (gerium_uint32_t) mips.size();
+        header.compression = (gerium_uint32_t) archive::Compression::None;
+        header.size        = (gerium_uint32_t) size;
+        header.storedSize  = (gerium_uint32_t) size;
+
+        std::unique_ptr<gerium_uint8_t[]> compressed;
+        if (compress && size) {
+            const auto bound = ZSTD_compressBound(size);
+            compressed       = std::make_unique<gerium_uint8_t[]>(bound);
+            const auto bytes = ZSTD_compress(compressed.get(), bound, payload.get(), size, ZSTD_CLEVEL_DEFAULT);
+            if (!ZSTD_isError(bytes) && bytes < size) {
+                header.compression = (gerium_uint32_t) archive::Compression::Zstd;
+                header.storedSize  = (gerium_uint32_t) bytes;
+                payload            = std::move(compressed);
+            }
+        }
+
+        const auto entriesSize = sizeof(Entry) * mips.size();
+        const auto totalSize   = sizeof(Header) + entriesSize + header.storedSize;
+        {
+            auto file = File::create(tempPath.c_str(), (gerium_uint32_t) totalSize);
+            auto data = (gerium_uint8_t*) file->map();
+
+            memcpy(data, &header, sizeof(Header));
+            data += sizeof(Header);
+
+            for (const auto& mip : mips) {
+                const Entry entry{ mip.size, mip.level };
+                memcpy(data, &entry, sizeof(Entry));
+                data += sizeof(Entry);
+            }
+
+            memcpy(data, payload.get(), header.storedSize);
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, _path, ec);
+        if (ec) {
+            File::deleteFile(tempPath.c_str());
+        }
+    } catch (...) {
+        File::deleteFile(tempPath.c_str());
+    }
+}
+
+const std::vector<TextureCache::Mip>& TextureCache::mips() const noexcept {
+    return _mips;
+}
+
+} // namespace gerium
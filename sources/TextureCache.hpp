@@ -0,0 +1,51 @@
+#ifndef GERIUM_TEXTURE_CACHE_HPP
+#define GERIUM_TEXTURE_CACHE_HPP
+
+#include "File.hpp"
+
+namespace gerium {
+
+class TextureCache final {
+public:
+    struct Mip {
+        gerium_cdata_t data;
+        gerium_uint32_t size;
+        gerium_uint8_t level;
+    };
+
+    TextureCache(gerium_cdata_t source, gerium_uint64_t sourceSize, gerium_uint32_t format, gerium_uint32_t device);
+
+    [[nodiscard]] bool load() noexcept;
+    void save(const std::vector<Mip>& mips, bool compress) noexcept;
+
+    [[nodiscard]] const std::vector<Mip>& mips() const noexcept;
+
+private:
+    struct Header {
+        gerium_uint32_t magic;
+        gerium_uint32_t version;
+        gerium_uint64_t key;
+        gerium_uint32_t mipCount;
+        gerium_uint32_t compression;
+        gerium_uint32_t size;
+        gerium_uint32_t storedSize;
+    };
+
+    struct Entry {
+        gerium_uint32_t size;
+        gerium_uint32_t level;
+    };
+
+    static constexpr gerium_uint32_t kMagic   = 0x43585447; // GTXC
+    static constexpr gerium_uint32_t kVersion = 1;
+
+    gerium_uint64_t _key;
+    std::string _path;
+    ObjectPtr<File> _file;
+    std::unique_ptr<gerium_uint8_t[]> _buffer;
+    std::vector<Mip> _mips;
+};
+
+} // namespace gerium
+
+#endif
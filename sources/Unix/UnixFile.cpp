@@ -1,5 +1,6 @@
 #include "UnixFile.hpp"
 
+#include <cerrno>
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -53,6 +54,10 @@ void UnixFile::createDirs(gerium_utf8_t path) {
     }
 }
 
+int UnixFile::descriptor() const noexcept {
+    return _file;
+}
+
 void UnixFile::reserveSpace(gerium_uint64_t size) const {
     if (size) {
 #ifdef __APPLE__
@@ -118,6 +123,22 @@ gerium_uint32_t UnixFile::onRead(gerium_data_t data, gerium_uint32_t size) noexc
     return (gerium_uint32_t)::read(_file, (void*) data, (size_t) size);
 }
 
+gerium_uint32_t UnixFile::onReadAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) {
+    while (true) {
+#ifdef __APPLE__
+        const auto result = ::pread(_file, (void*) data, (size_t) size, off_t(offset));
+#else
+        const auto result = ::pread64(_file, (void*) data, (size_t) size, off64_t(offset));
+#endif
+        if (result >= 0) {
+            return (gerium_uint32_t) result;
+        }
+        if (errno != EINTR) {
+            error(GERIUM_RESULT_ERROR_FILE_READ);
+        }
+    }
+}
+
 gerium_data_t UnixFile::onMap() noexcept {
     if (!_data) {
         _dataSize = onGetSize();
@@ -15,6 +15,8 @@ public:
 protected:
     static void createDirs(gerium_utf8_t path);
 
+    int descriptor() const noexcept;
+
 private:
     void reserveSpace(gerium_uint64_t size) const;
 
@@ -23,6 +25,7 @@ private:
     void onWrite(gerium_cdata_t data, gerium_uint32_t size) override final;
     gerium_uint32_t onRead(gerium_data_t data, gerium_uint32_t size) noexcept override final;
     gerium_data_t onMap() noexcept override final;
+    gerium_uint32_t onReadAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) override final;
 
     int _file;
     gerium_data_t _data;
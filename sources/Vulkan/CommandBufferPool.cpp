@@ -52,12 +52,74 @@ void CommandBuffer::addImageBarrier(TextureHandle handle,
 
     _device->vkTable().vkCmdPipelineBarrier(
         _commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    ++_counters.barriers;
 
     for (gerium_uint32_t mip = mipLevel; mip < mipLevel + mipCount; ++mip) {
         states[mip] = newState;
     }
 }
 
+void CommandBuffer::addImageBarriers(gerium_uint32_t count,
+                                     const TextureCopy* textures,
+                                     ResourceState newState,
+                                     QueueType srcQueueType,
+                                     QueueType dstQueueType) {
+    auto srcFamily = srcQueueType == dstQueueType ? VK_QUEUE_FAMILY_IGNORED : getFamilyIndex(srcQueueType);
+    auto dstFamily = srcQueueType == dstQueueType ? VK_QUEUE_FAMILY_IGNORED : getFamilyIndex(dstQueueType);
+
+    VkPipelineStageFlags srcStageMask = 0;
+    VkPipelineStageFlags dstStageMask = 0;
+
+    _imageBarriers.clear();
+    for (gerium_uint32_t i = 0; i < count; ++i) {
+        auto texture = _device->_textures.access(textures[i].texture);
+        auto states  = getTextureStates(textures[i].texture);
+        auto mip     = textures[i].mip;
+
+        if (states[mip] == newState) {
+            continue;
+        }
+
+        VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+        barrier.srcAccessMask                   = toVkAccessFlags(states[mip]);
+        barrier.dstAccessMask                   = toVkAccessFlags(newState);
+        barrier.oldLayout                       = toVkImageLayout(states[mip]);
+        barrier.newLayout                       = toVkImageLayout(newState);
+        barrier.srcQueueFamilyIndex             = srcFamily;
+        barrier.dstQueueFamilyIndex             = dstFamily;
+        barrier.image                           = texture->vkImage;
+        barrier.subresourceRange.aspectMask     = toVkImageAspect(texture->vkFormat);
+        barrier.subresourceRange.baseMipLevel   = mip;
+        barrier.subresourceRange.levelCount     = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount     = texture->layers;
+
+        if (hasStencil(texture->vkFormat)) {
+            barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+
+        srcStageMask |= utilDeterminePipelineStageFlags(barrier.srcAccessMask, srcQueueType);
+        dstStageMask |= utilDeterminePipelineStageFlags(barrier.dstAccessMask, dstQueueType);
+
+        _imageBarriers.push_back(barrier);
+        states[mip] = newState;
+    }
+
+    if (!_imageBarriers.empty()) {
+        _device->vkTable().vkCmdPipelineBarrier(_commandBuffer,
+                                                srcStageMask,
+                                                dstStageMask,
+                                                0,
+                                                0,
+                                                nullptr,
+                                                0,
+                                                nullptr,
+                                                (uint32_t) _imageBarriers.size(),
+                                                _imageBarriers.data());
+        _counters.barriers += _imageBarriers.size();
+    }
+}
+
 void CommandBuffer::addBufferBarrier(BufferHandle handle,
                                      ResourceState dstState,
                                      QueueType srcQueueType,
@@ -83,6 +145,7 @@ void CommandBuffer::addBufferBarrier(BufferHandle handle,
 
     _device->vkTable().vkCmdPipelineBarrier(
         _commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    ++_counters.barriers;
     buffer->state = dstState;
 }
 
@@ -104,6 +167,11 @@ void CommandBuffer::bindPass(RenderPassHandle renderPass,
     if (_currentRenderPass != renderPass) {
         endCurrentRenderPass();
 
+        if (_device->dynamicRenderingSupported()) {
+            beginRendering(renderPass, framebuffer, useSecondaryCommandBuffers);
+            return;
+        }
+
         auto renderPassObj  = _device->_renderPasses.access(renderPass);
         auto framebufferObj = _device->_framebuffers.access(framebuffer);
 
@@ -139,24 +207,129 @@ void CommandBuffer::bindPass(RenderPassHandle renderPass,
     }
 }
 
-void CommandBuffer::copyBuffer(BufferHandle src, BufferHandle dst) {
-    auto srcBuffer = _device->_buffers.access(src);
-    auto dstBuffer = _device->_buffers.access(dst);
+void CommandBuffer::beginRendering(RenderPassHandle renderPass,
+                                   FramebufferHandle framebuffer,
+                                   bool useSecondaryCommandBuffers) {
+    auto renderPassObj  = _device->_renderPasses.access(renderPass);
+    auto framebufferObj = _device->_framebuffers.access(framebuffer);
+
+    const auto& output = renderPassObj->output;
+
+    // The frame graph moves attachments into the attachment layouts with its own barriers, only images that
+    // leave the pass in another layout (swapchain images) are transitioned here, as the render pass did
+    transitionAttachments(*renderPassObj, *framebufferObj, true);
+
+    VkRenderingAttachmentInfoKHR colorAttachments[kMaxImageOutputs]{};
+    for (gerium_uint32_t i = 0; i < framebufferObj->numColorAttachments; ++i) {
+        auto texture = _device->_textures.access(framebufferObj->colorAttachments[i]);
+
+        auto& attachment       = colorAttachments[i];
+        attachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        attachment.imageView   = texture->vkImageView;
+        attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        attachment.loadOp      = toVkAttachmentLoadOp(output.colorOperations[i]);
+        attachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+        attachment.clearValue  = _clearColors[i];
+    }
 
-    auto srcOffset = 0;
-    auto srcSize   = srcBuffer->size;
+    VkRenderingAttachmentInfoKHR depthAttachment{ VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR };
+    VkRenderingAttachmentInfoKHR stencilAttachment{ VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR };
+    if (framebufferObj->depthStencilAttachment != Undefined) {
+        auto texture = _device->_textures.access(framebufferObj->depthStencilAttachment);
 
-    if (srcBuffer->parent != Undefined) {
-        srcBuffer = _device->_buffers.access(srcBuffer->parent);
-        srcOffset = srcBuffer->globalOffset;
+        depthAttachment.imageView   = texture->vkImageView;
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp      = toVkAttachmentLoadOp(output.depthOperation);
+        depthAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.clearValue  = _clearDepthStencil;
+
+        stencilAttachment        = depthAttachment;
+        stencilAttachment.loadOp = toVkAttachmentLoadOp(output.stencilOperation);
     }
 
+    const auto depthFormat = output.depthStencilFormat;
+    const auto flags       = useSecondaryCommandBuffers ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+
+    VkRenderingInfoKHR renderingInfo{ VK_STRUCTURE_TYPE_RENDERING_INFO_KHR };
+    renderingInfo.flags                = flags;
+    renderingInfo.renderArea.offset    = { 0, 0 };
+    renderingInfo.renderArea.extent    = { framebufferObj->width, framebufferObj->height };
+    renderingInfo.layerCount           = std::max<uint32_t>(framebufferObj->layers, 1);
+    renderingInfo.colorAttachmentCount = framebufferObj->numColorAttachments;
+    renderingInfo.pColorAttachments    = colorAttachments;
+    renderingInfo.pDepthAttachment     = hasDepth(depthFormat) ? &depthAttachment : nullptr;
+    renderingInfo.pStencilAttachment   = hasStencil(depthFormat) ? &stencilAttachment : nullptr;
+    _device->vkTable().vkCmdBeginRenderingKHR(_commandBuffer, &renderingInfo);
+
+    _currentRenderPass  = renderPass;
+    _currentFramebuffer = framebuffer;
+}
+
+void CommandBuffer::transitionAttachments(const RenderPass& renderPass, const Framebuffer& framebuffer, bool begin) {
+    VkImageMemoryBarrier barriers[kMaxImageOutputs];
+    gerium_uint32_t barrierCount = 0;
+
+    for (gerium_uint32_t i = 0; i < framebuffer.numColorAttachments; ++i) {
+        if (renderPass.output.colorFinalLayouts[i] != VK_IMAGE_LAYOUT_PRESENT_SRC_KHR) {
+            continue;
+        }
+
+        const auto load = renderPass.output.colorOperations[i] == RenderPassOp::Load;
+
+        VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+        if (begin) {
+            barrier.srcAccessMask = VK_ACCESS_NONE;
+            barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.oldLayout     = load ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        } else {
+            barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_NONE;
+            barrier.oldLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barrier.newLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        }
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = _device->_textures.access(framebuffer.colorAttachments[i])->vkImage;
+        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel   = 0;
+        barrier.subresourceRange.levelCount     = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount     = 1;
+
+        barriers[barrierCount++] = barrier;
+    }
+
+    if (barrierCount) {
+        const auto dstStageMask =
+            begin ? VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        _device->vkTable().vkCmdPipelineBarrier(_commandBuffer,
+                                                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                                dstStageMask,
+                                                0,
+                                                0,
+                                                nullptr,
+                                                0,
+                                                nullptr,
+                                                barrierCount,
+                                                barriers);
+        _counters.barriers += barrierCount;
+    }
+}
+
+void CommandBuffer::copyBuffer(BufferHandle src, BufferHandle dst) {
+    // Both buffers may be ranges of a parent buffer (dynamic buffers, small buffers from the heap)
+    auto [srcVkBuffer, srcOffset] = getVkBuffer(src, 0);
+    auto [dstVkBuffer, dstOffset] = getVkBuffer(dst, 0);
+
+    auto srcSize = _device->_buffers.access(src)->size;
+
     VkBufferMemoryBarrier barrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
     barrier.srcAccessMask       = VK_ACCESS_HOST_WRITE_BIT;
     barrier.dstAccessMask       = VK_ACCESS_TRANSFER_READ_BIT;
     barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.buffer              = srcBuffer->vkBuffer;
+    barrier.buffer              = srcVkBuffer;
     barrier.offset              = srcOffset;
     barrier.size                = srcSize;
 
@@ -166,15 +339,15 @@ void CommandBuffer::copyBuffer(BufferHandle src, BufferHandle dst) {
     _device->vkTable().vkCmdPipelineBarrier(
         _commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
 
-    VkBufferCopy bufferCopy = { (VkDeviceSize) srcOffset, 0, srcSize };
-    _device->vkTable().vkCmdCopyBuffer(_commandBuffer, srcBuffer->vkBuffer, dstBuffer->vkBuffer, 1, &bufferCopy);
+    VkBufferCopy bufferCopy = { srcOffset, dstOffset, srcSize };
+    _device->vkTable().vkCmdCopyBuffer(_commandBuffer, srcVkBuffer, dstVkBuffer, 1, &bufferCopy);
 
     VkBufferMemoryBarrier barrier2{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
     barrier2.srcAccessMask       = VK_ACCESS_TRANSFER_READ_BIT;
     barrier2.dstAccessMask       = VK_ACCESS_SHADER_READ_BIT;
     barrier2.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier2.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier2.buffer              = srcBuffer->vkBuffer;
+    barrier2.buffer              = srcVkBuffer;
     barrier2.offset              = srcOffset;
     barrier2.size                = srcSize;
 
@@ -183,6 +356,9 @@ void CommandBuffer::copyBuffer(BufferHandle src, BufferHandle dst) {
 
     _device->vkTable().vkCmdPipelineBarrier(
         _commandBuffer, srcStageMask2, dstStageMask2, 0, 0, nullptr, 1, &barrier2, 0, nullptr);
+
+    _counters.barriers += 2;
+    ++_counters.uploads;
 }
 
 void CommandBuffer::copyBuffer(BufferHandle src, TextureHandle dst, gerium_uint8_t mip, gerium_uint32_t offset) {
@@ -199,24 +375,74 @@ void CommandBuffer::copyBuffer(BufferHandle src, TextureHandle dst, gerium_uint8
         srcBuffer = _device->_buffers.access(srcBuffer->parent);
     }
 
-    const auto width  = std::max(static_cast<uint32_t>(dstTexture->width * std::pow(0.5, mip)), 1U);
-    const auto height = std::max(static_cast<uint32_t>(dstTexture->height * std::pow(0.5, mip)), 1U);
-    const auto depth  = std::max(static_cast<uint32_t>(dstTexture->depth * std::pow(0.5, mip)), 1U);
-
-    VkBufferImageCopy region{};
-    region.bufferOffset                    = (VkDeviceSize) srcOffset;
-    region.bufferRowLength                 = 0;
-    region.bufferImageHeight               = 0;
-    region.imageSubresource.aspectMask     = toVkImageAspect(dstTexture->vkFormat);
-    region.imageSubresource.mipLevel       = mip;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount     = 1;
-    region.imageOffset                     = { 0, 0, 0 };
-    region.imageExtent                     = { width, height, depth };
+    const auto region = getTextureCopyRegion(dstTexture, mip, (VkDeviceSize) srcOffset);
 
     addImageBarrier(dst, ResourceState::CopyDest, mip, 1, queue, queue);
     _device->vkTable().vkCmdCopyBufferToImage(
         _commandBuffer, srcBuffer->vkBuffer, dstTexture->vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    ++_counters.uploads;
+}
+
+void CommandBuffer::copyBuffer(gerium_uint32_t count, const TextureCopy* copies) {
+    // Only staging buffers are used as upload sources here
+    addImageBarriers(count, copies, ResourceState::CopyDest, QueueType::CopyTransfer, QueueType::CopyTransfer);
+
+    for (gerium_uint32_t i = 0; i < count; ++i) {
+        auto srcBuffer    = _device->_buffers.access(copies[i].buffer);
+        auto srcOffset    = srcBuffer->globalOffset + copies[i].offset;
+        auto dstTexture   = _device->_textures.access(copies[i].texture);
+        const auto region = getTextureCopyRegion(dstTexture, copies[i].mip, (VkDeviceSize) srcOffset);
+
+        if (srcBuffer->parent != Undefined) {
+            srcBuffer = _device->_buffers.access(srcBuffer->parent);
+        }
+
+        _device->vkTable().vkCmdCopyBufferToImage(
+            _commandBuffer, srcBuffer->vkBuffer, dstTexture->vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+    _counters.uploads += count;
+}
+
+void CommandBuffer::copyTexture(TextureHandle src,
+                                gerium_uint8_t srcMip,
+                                TextureHandle dst,
+                                gerium_uint8_t dstMip,
+                                gerium_uint8_t mipCount) {
+    auto srcTexture = _device->_textures.access(src);
+    auto dstTexture = _device->_textures.access(dst);
+
+    addImageBarrier(src, ResourceState::CopySource, srcMip, mipCount);
+    addImageBarrier(dst, ResourceState::CopyDest, dstMip, mipCount);
+
+    VkImageCopy regions[16];
+    assert(mipCount <= std::size(regions));
+    for (gerium_uint8_t i = 0; i < mipCount; ++i) {
+        auto& region = regions[i];
+
+        region                               = {};
+        region.srcSubresource.aspectMask     = toVkImageAspect(srcTexture->vkFormat);
+        region.srcSubresource.mipLevel       = srcMip + i;
+        region.srcSubresource.baseArrayLayer = 0;
+        region.srcSubresource.layerCount     = srcTexture->layers;
+        region.dstSubresource.aspectMask     = toVkImageAspect(dstTexture->vkFormat);
+        region.dstSubresource.mipLevel       = dstMip + i;
+        region.dstSubresource.baseArrayLayer = 0;
+        region.dstSubresource.layerCount     = dstTexture->layers;
+        region.extent.width                  = std::max(srcTexture->width >> (srcMip + i), 1);
+        region.extent.height                 = std::max(srcTexture->height >> (srcMip + i), 1);
+        region.extent.depth                  = std::max(srcTexture->depth >> (srcMip + i), 1);
+    }
+
+    _device->_vkTable.vkCmdCopyImage(_commandBuffer,
+                                     srcTexture->vkImage,
+                                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                     dstTexture->vkImage,
+                                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                     mipCount,
+                                     regions);
+
+    addImageBarrier(src, ResourceState::ShaderResource, srcMip, mipCount);
+    addImageBarrier(dst, ResourceState::ShaderResource, dstMip, mipCount);
 }
 
 void CommandBuffer::generateMipmaps(TextureHandle handle) {
@@ -274,6 +500,30 @@ void CommandBuffer::popMarker() {
     }
 }
 
+void CommandBuffer::beginStatistics(gerium_utf8_t name) {
+    if (_device->isProfilerEnable()) {
+        if (auto queryIndex = _device->profiler()->beginStatistics(name); queryIndex != VkProfiler::kNoQuery) {
+            _device->vkTable().vkCmdBeginQuery(_commandBuffer, _device->_statisticsQueryPool, queryIndex, 0);
+            _statisticsQuery  = queryIndex;
+            _statisticsActive = true;
+        }
+    }
+}
+
+void CommandBuffer::endStatistics() {
+    if (_statisticsActive) {
+        _device->vkTable().vkCmdEndQuery(_commandBuffer, _device->_statisticsQueryPool, _statisticsQuery);
+        _statisticsActive = false;
+    }
+}
+
+void CommandBuffer::flushCounters(gerium_uint32_t node) noexcept {
+    if (_device->isProfilerEnable()) {
+        _device->profiler()->addRenderCounters(node, _counters);
+    }
+    _counters = {};
+}
+
 void CommandBuffer::pushLabel(gerium_utf8_t name) {
     if (_device->_enableDebugNames) {
         const auto color = nameColorVec4(name);
@@ -294,12 +544,21 @@ void CommandBuffer::popLabel() {
     }
 }
 
-void CommandBuffer::submit(QueueType queue, bool wait) {
+void CommandBuffer::submit(QueueType queue, bool wait, VkSemaphore timeline, gerium_uint64_t timelineValue) {
     end();
 
+    VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues    = &timelineValue;
+
     VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers    = &_commandBuffer;
+    if (timeline) {
+        submitInfo.pNext                = &timelineInfo;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores    = &timeline;
+    }
 
     VkQueue vkQueue;
     switch (queue) {
@@ -337,14 +596,33 @@ void CommandBuffer::begin(RenderPassHandle renderPass, FramebufferHandle framebu
     _currentFramebuffer = Undefined;
     _currentPipeline    = Undefined;
 
+    VkCommandBufferInheritanceRenderingInfoKHR renderingInfo{
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR
+    };
     VkCommandBufferInheritanceInfo inheritanceInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
     if (isSecondary) {
         auto renderPassObj  = _device->_renderPasses.access(renderPass);
         auto framebufferObj = _device->_framebuffers.access(framebuffer);
 
-        inheritanceInfo.renderPass  = renderPassObj->vkRenderPass;
-        inheritanceInfo.subpass     = 0;
-        inheritanceInfo.framebuffer = framebufferObj->vkFramebuffer;
+        if (_device->dynamicRenderingSupported()) {
+            const auto depthFormat = renderPassObj->output.depthStencilFormat;
+
+            renderingInfo.colorAttachmentCount    = renderPassObj->output.numColorFormats;
+            renderingInfo.pColorAttachmentFormats = renderPassObj->output.colorFormats;
+            renderingInfo.depthAttachmentFormat   = hasDepth(depthFormat) ? depthFormat : VK_FORMAT_UNDEFINED;
+            renderingInfo.stencilAttachmentFormat = hasStencil(depthFormat) ? depthFormat : VK_FORMAT_UNDEFINED;
+            renderingInfo.rasterizationSamples    = VK_SAMPLE_COUNT_1_BIT;
+            inheritanceInfo.pNext                 = &renderingInfo;
+        } else {
+            inheritanceInfo.renderPass  = renderPassObj->vkRenderPass;
+            inheritanceInfo.subpass     = 0;
+            inheritanceInfo.framebuffer = framebufferObj->vkFramebuffer;
+        }
+
+        // Secondary buffers of a pass are executed inside its pipeline statistics query
+        if (_device->inheritedQueriesSupported()) {
+            inheritanceInfo.pipelineStatistics = _device->pipelineStatistics();
+        }
     }
 
     VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
@@ -358,13 +636,21 @@ void CommandBuffer::begin(RenderPassHandle renderPass, FramebufferHandle framebu
 
 void CommandBuffer::end() {
     _device->vkTable().vkEndCommandBuffer(_commandBuffer);
+    flushCounters(Profiler::kNoCounterNode);
 
     _recording = false;
 }
 
 void CommandBuffer::endCurrentRenderPass() {
     if (_currentRenderPass != Undefined) {
-        _device->vkTable().vkCmdEndRenderPass(_commandBuffer);
+        if (_device->dynamicRenderingSupported()) {
+            _device->vkTable().vkCmdEndRenderingKHR(_commandBuffer);
+            transitionAttachments(*_device->_renderPasses.access(_currentRenderPass),
+                                  *_device->_framebuffers.access(_currentFramebuffer),
+                                  false);
+        } else {
+            _device->vkTable().vkCmdEndRenderPass(_commandBuffer);
+        }
         _currentRenderPass  = Undefined;
         _currentFramebuffer = Undefined;
     }
@@ -418,6 +704,7 @@ void CommandBuffer::onBindTechnique(TechniqueHandle handle) noexcept {
         auto pipelineObj = _device->_pipelines.access(pipeline);
         _device->vkTable().vkCmdBindPipeline(_commandBuffer, pipelineObj->vkBindPoint, pipelineObj->vkPipeline);
         _currentPipeline = pipeline;
+        ++_counters.pipeline_binds;
 
         for (uint32_t i = 0; i < pipelineObj->numActiveLayouts; ++i) {
             if (pipelineObj->descriptorSetLayoutHandles[i] == Undefined) {
@@ -435,11 +722,13 @@ void CommandBuffer::onBindTechnique(TechniqueHandle handle) noexcept {
 }
 
 void CommandBuffer::onBindVertexBuffer(BufferHandle handle, gerium_uint32_t binding, gerium_uint32_t offset) noexcept {
+    _device->markUsed(handle);
     auto [vkBuffer, vkOffset] = getVkBuffer(handle, offset);
     _device->vkTable().vkCmdBindVertexBuffers(_commandBuffer, binding, 1, &vkBuffer, &vkOffset);
 }
 
 void CommandBuffer::onBindIndexBuffer(BufferHandle handle, gerium_uint32_t offset, gerium_index_type_t type) noexcept {
+    _device->markUsed(handle);
     auto [vkBuffer, vkOffset] = getVkBuffer(handle, offset);
     _device->vkTable().vkCmdBindIndexBuffer(_commandBuffer, vkBuffer, vkOffset, toVkIndexType(type));
 }
@@ -455,6 +744,7 @@ void CommandBuffer::onBindDescriptorSet(DescriptorSetHandle handle, gerium_uint3
 void CommandBuffer::onDispatch(gerium_uint32_t groupX, gerium_uint32_t groupY, gerium_uint32_t groupZ) noexcept {
     bindDescriptorSets();
     _device->vkTable().vkCmdDispatch(_commandBuffer, groupX, groupY, groupZ);
+    ++_counters.dispatches;
 }
 
 void CommandBuffer::onDraw(gerium_uint32_t firstVertex,
@@ -463,6 +753,7 @@ void CommandBuffer::onDraw(gerium_uint32_t firstVertex,
                            gerium_uint32_t instanceCount) noexcept {
     bindDescriptorSets();
     _device->vkTable().vkCmdDraw(_commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+    ++_counters.draws;
 }
 
 void CommandBuffer::onDrawIndexed(gerium_uint32_t firstIndex,
@@ -473,6 +764,7 @@ void CommandBuffer::onDrawIndexed(gerium_uint32_t firstIndex,
     bindDescriptorSets();
     _device->vkTable().vkCmdDrawIndexed(
         _commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    ++_counters.draws;
 }
 
 void CommandBuffer::onDrawIndexedIndirect(BufferHandle handle,
@@ -481,6 +773,7 @@ void CommandBuffer::onDrawIndexedIndirect(BufferHandle handle,
                                           gerium_uint32_t drawCountOffset,
                                           gerium_uint32_t drawCount,
                                           gerium_uint32_t stride) noexcept {
+    _device->markUsed(handle);
     auto [vkBuffer, vkOffset] = getVkBuffer(handle, offset);
 
     bindDescriptorSets();
@@ -491,21 +784,27 @@ void CommandBuffer::onDrawIndexedIndirect(BufferHandle handle,
         _device->vkTable().vkCmdDrawIndexedIndirectCount(
             _commandBuffer, vkBuffer, vkOffset, vkBufferCount, vkOffsetCount, drawCount, stride);
     }
+    ++_counters.draws;
+    ++_counters.indirect_calls;
 }
 
 void CommandBuffer::onDrawMeshTasks(gerium_uint32_t groupX, gerium_uint32_t groupY, gerium_uint32_t groupZ) noexcept {
     bindDescriptorSets();
     _device->vkTable().vkCmdDrawMeshTasksEXT(_commandBuffer, groupX, groupY, groupZ);
+    ++_counters.mesh_task_launches;
 }
 
 void CommandBuffer::onDrawMeshTasksIndirect(BufferHandle handle,
                                             gerium_uint32_t offset,
                                             gerium_uint32_t drawCount,
                                             gerium_uint32_t stride) noexcept {
+    _device->markUsed(handle);
     auto [vkBuffer, vkOffset] = getVkBuffer(handle, offset);
 
     bindDescriptorSets();
     _device->vkTable().vkCmdDrawMeshTasksIndirectEXT(_commandBuffer, vkBuffer, vkOffset, drawCount, stride);
+    ++_counters.mesh_task_launches;
+    ++_counters.indirect_calls;
 }
 
 void CommandBuffer::onFillBuffer(BufferHandle handle,
@@ -558,7 +857,9 @@ void CommandBuffer::bindDescriptorSets() {
             if (descriptorSet) {
                 auto layoutHandle    = pipeline->descriptorSetLayoutHandles[set];
                 auto layout          = _device->_descriptorSetLayouts.access(layoutHandle);
-                auto vkDescriptorSet = _device->updateDescriptorSet(handle, layoutHandle, _currentFrameGraph);
+                auto [vkDescriptorSet, allocated] =
+                    _device->updateDescriptorSet(handle, layoutHandle, _currentFrameGraph);
+                _counters.descriptor_set_allocations += allocated ? 1 : 0;
                 for (const auto& binding : layout->data.bindings) {
                     if (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
                         binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) {
@@ -579,6 +880,7 @@ void CommandBuffer::bindDescriptorSets() {
                                                            descriptorSets,
                                                            numOffsets,
                                                            offsets);
+                _counters.descriptor_set_binds += numDescriptorSets;
             }
             firstSet          = set + 1;
             numDescriptorSets = 0;
@@ -595,6 +897,7 @@ void CommandBuffer::bindDescriptorSets() {
                                                    descriptorSets,
                                                    numOffsets,
                                                    offsets);
+        _counters.descriptor_set_binds += numDescriptorSets;
     }
 }
 
@@ -628,6 +931,26 @@ std::pair<VkBuffer, VkDeviceSize> CommandBuffer::getVkBuffer(BufferHandle handle
     return { vkBuffer, vkOffset };
 }
 
+VkBufferImageCopy CommandBuffer::getTextureCopyRegion(const Texture* texture,
+                                                      gerium_uint8_t mip,
+                                                      VkDeviceSize offset) const noexcept {
+    const auto width  = std::max(static_cast<uint32_t>(texture->width * std::pow(0.5, mip)), 1U);
+    const auto height = std::max(static_cast<uint32_t>(texture->height * std::pow(0.5, mip)), 1U);
+    const auto depth  = std::max(static_cast<uint32_t>(texture->depth * std::pow(0.5, mip)), 1U);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset                    = offset;
+    region.bufferRowLength                 = 0;
+    region.bufferImageHeight               = 0;
+    region.imageSubresource.aspectMask     = toVkImageAspect(texture->vkFormat);
+    region.imageSubresource.mipLevel       = mip;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount     = 1;
+    region.imageOffset                     = { 0, 0, 0 };
+    region.imageExtent                     = { width, height, depth };
+    return region;
+}
+
 ResourceState* CommandBuffer::getTextureStates(TextureHandle handle) noexcept {
     auto texture = _device->_textures.access(handle);
     auto states  = texture->states;
@@ -662,7 +985,7 @@ void CommandBufferPool::create(Device& device,
             break;
     }
 
-    const auto totalPools = _threadCount * kMaxFrames;
+    const auto totalPools = _threadCount * _device->framesInFlight();
 
     _vkCommandPools.resize(totalPools);
 
@@ -678,7 +1001,7 @@ void CommandBufferPool::create(Device& device,
     _indices.resize(totalPools);
     VkCommandBuffer buffers[100] = {};
 
-    for (gerium_uint32_t frame = 0; frame < kMaxFrames; ++frame) {
+    for (gerium_uint32_t frame = 0; frame < _device->framesInFlight(); ++frame) {
         for (gerium_uint32_t thread = 0; thread < _threadCount; ++thread) {
             const auto poolIndex = getPoolIndex(frame, thread);
 
@@ -739,7 +1062,13 @@ CommandBuffer* CommandBufferPool::getPrimary(gerium_uint32_t frame, bool profile
     if (profile && _device->isProfilerEnable() && !_device->profiler()->hasTimestamps()) {
         const auto queriesPerFrame = _device->profiler()->queriesPerFrame();
         _device->vkTable().vkCmdResetQueryPool(
-            commandBuffer.vkCommandBuffer(), _device->vkQueryPool(), frame * queriesPerFrame * 2, queriesPerFrame);
+            commandBuffer.vkCommandBuffer(), _device->vkQueryPool(), frame * queriesPerFrame * 2, queriesPerFrame * 2);
+        if (_device->vkStatisticsQueryPool()) {
+            _device->vkTable().vkCmdResetQueryPool(commandBuffer.vkCommandBuffer(),
+                                                   _device->vkStatisticsQueryPool(),
+                                                   frame * queriesPerFrame,
+                                                   queriesPerFrame);
+        }
     }
 
     _indices[poolIndex] = (_indices[poolIndex] + 1) % _buffersPerFrame;
@@ -765,7 +1094,7 @@ CommandBuffer* CommandBufferPool::getSecondary(gerium_uint32_t frame,
     if (profile && _device->isProfilerEnable() && !_device->profiler()->hasTimestamps()) {
         const auto queriesPerFrame = _device->profiler()->queriesPerFrame();
         _device->vkTable().vkCmdResetQueryPool(
-            commandBuffer.vkCommandBuffer(), _device->vkQueryPool(), frame * queriesPerFrame * 2, queriesPerFrame);
+            commandBuffer.vkCommandBuffer(), _device->vkQueryPool(), frame * queriesPerFrame * 2, queriesPerFrame * 2);
     }
 
     _indices[poolIndex] = (_indices[poolIndex] + 1) % _buffersPerFrame;
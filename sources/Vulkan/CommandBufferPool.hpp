@@ -9,6 +9,13 @@ namespace gerium::vulkan {
 
 class Device;
 
+struct TextureCopy {
+    BufferHandle buffer;
+    TextureHandle texture;
+    gerium_uint8_t mip;
+    gerium_uint32_t offset;
+};
+
 class CommandBuffer final : public gerium::CommandBuffer {
 public:
     CommandBuffer() = default;
@@ -20,6 +27,11 @@ public:
                          gerium_uint32_t mipCount,
                          QueueType srcQueueType = QueueType::Graphics,
                          QueueType dstQueueType = QueueType::Graphics);
+    void addImageBarriers(gerium_uint32_t count,
+                          const TextureCopy* textures,
+                          ResourceState newState,
+                          QueueType srcQueueType = QueueType::Graphics,
+                          QueueType dstQueueType = QueueType::Graphics);
     void addBufferBarrier(BufferHandle handle,
                           ResourceState dstState,
                           QueueType srcQueueType = QueueType::Graphics,
@@ -33,12 +45,24 @@ public:
     void bindPass(RenderPassHandle renderPass, FramebufferHandle framebuffer, bool useSecondaryCommandBuffers);
     void copyBuffer(BufferHandle src, BufferHandle dst);
     void copyBuffer(BufferHandle src, TextureHandle dst, gerium_uint8_t mip, gerium_uint32_t offset = 0);
+    void copyBuffer(gerium_uint32_t count, const TextureCopy* copies);
+    void copyTexture(TextureHandle src,
+                     gerium_uint8_t srcMip,
+                     TextureHandle dst,
+                     gerium_uint8_t dstMip,
+                     gerium_uint8_t mipCount);
     void generateMipmaps(TextureHandle handle);
     void pushMarker(gerium_utf8_t name);
     void popMarker();
+    void beginStatistics(gerium_utf8_t name);
+    void endStatistics();
+    void flushCounters(gerium_uint32_t node) noexcept;
     void pushLabel(gerium_utf8_t name);
     void popLabel();
-    void submit(QueueType queue, bool wait = true);
+    void submit(QueueType queue,
+                bool wait                     = true,
+                VkSemaphore timeline          = VK_NULL_HANDLE,
+                gerium_uint64_t timelineValue = 0);
     void execute(gerium_uint32_t numCommandBuffers, CommandBuffer* commandBuffers[]);
 
     void begin(RenderPassHandle renderPass = Undefined, FramebufferHandle framebuffer = Undefined);
@@ -100,10 +124,15 @@ private:
 
     FfxCommandList onGetFfxCommandList() noexcept override;
 
+    void beginRendering(RenderPassHandle renderPass, FramebufferHandle framebuffer, bool useSecondaryCommandBuffers);
+    void transitionAttachments(const RenderPass& renderPass, const Framebuffer& framebuffer, bool begin);
     void bindDescriptorSets();
     uint32_t getFamilyIndex(QueueType queue) const noexcept;
     std::pair<VkBuffer, VkDeviceSize> getVkBuffer(BufferHandle handle, gerium_uint32_t offset) const noexcept;
     ResourceState* getTextureStates(TextureHandle handle) noexcept;
+    VkBufferImageCopy getTextureCopyRegion(const Texture* texture,
+                                           gerium_uint8_t mip,
+                                           VkDeviceSize offset) const noexcept;
 
     Device* _device{};
     VkCommandBuffer _commandBuffer{};
@@ -116,7 +145,11 @@ private:
     VkClearValue _clearColors[kMaxImageOutputs]{};
     VkClearValue _clearDepthStencil{};
     gerium_uint16_t _framebufferHeight{};
+    gerium_uint32_t _statisticsQuery{};
+    bool _statisticsActive{};
     bool _recording{};
+    gerium_render_counters_t _counters{};
+    std::vector<VkImageMemoryBarrier> _imageBarriers;
 };
 
 class CommandBufferPool final {
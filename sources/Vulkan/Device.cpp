@@ -8,6 +8,8 @@ namespace gerium::vulkan {
 Device::~Device() {
     if (_device) {
         _vkTable.vkDeviceWaitIdle(_device);
+        _releaseGroup.wait();
+        finishDefragmentation();
 
         ImGui_ImplVulkan_Shutdown();
         _application->shutdownImGui();
@@ -58,20 +60,29 @@ Device::~Device() {
         }
         deleteResources(true);
 
+        // Suballocated buffers return their ranges to the heap blocks, so the blocks are destroyed last
+        for (auto buffer : _buffers) {
+            if (!buffer->heapBlock) {
+                destroyBuffer(_buffers.handle(buffer));
+            }
+        }
+        deleteResources(true);
+
         for (auto buffer : _buffers) {
             destroyBuffer(_buffers.handle(buffer));
         }
         deleteResources(true);
+        releaseRecycled(true);
 
         if (_swapchain) {
             _vkTable.vkDestroySwapchainKHR(_device, _swapchain, getAllocCalls());
         }
 
-        for (uint32_t i = 0; i < kMaxFrames; ++i) {
+        for (uint32_t i = 0; i < _framesInFlight; ++i) {
             _vkTable.vkDestroySemaphore(_device, _imageAvailableSemaphores[i], getAllocCalls());
             _vkTable.vkDestroySemaphore(_device, _renderFinishedSemaphores[i], getAllocCalls());
-            _vkTable.vkDestroyFence(_device, _inFlightFences[i], getAllocCalls());
         }
+        _vkTable.vkDestroySemaphore(_device, _frameTimeline, getAllocCalls());
 
         if (_vmaAllocator) {
             vmaDestroyAllocator(_vmaAllocator);
@@ -97,6 +108,10 @@ Device::~Device() {
             _vkTable.vkDestroyQueryPool(_device, _queryPool, getAllocCalls());
         }
 
+        if (_statisticsQueryPool) {
+            _vkTable.vkDestroyQueryPool(_device, _statisticsQueryPool, getAllocCalls());
+        }
+
         _commandBufferPool.destroy();
 
         _vkTable.vkDestroyDevice(_device, getAllocCalls());
@@ -114,10 +129,13 @@ Device::~Device() {
 void Device::create(Application* application,
                     gerium_feature_flags_t features,
                     gerium_uint32_t version,
-                    bool enableValidations) {
+                    bool enableValidations,
+                    gerium_uint32_t framesInFlight) {
     _enableValidations = enableValidations;
     _enableDebugNames  = enableValidations;
     _application       = application;
+    _framesInFlight    = framesInFlight ? std::clamp(framesInFlight, 2U, kMaxFrames) : kDefaultFramesInFlight;
+    _previousFrame     = _framesInFlight - 1;
     _logger            = Logger::create("gerium:renderer:vulkan");
     _logger->setLevel(enableValidations ? GERIUM_LOGGER_LEVEL_DEBUG : GERIUM_LOGGER_LEVEL_OFF);
     _application->getSize(&_appWidth, &_appHeight);
@@ -139,6 +157,8 @@ void Device::create(Application* application,
 }
 
 bool Device::newFrame() {
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_DEVICE);
+
     gerium_uint16_t width, height;
     _application->getSize(&width, &height);
 
@@ -146,10 +166,12 @@ bool Device::newFrame() {
         return false;
     }
 
-    constexpr auto max = std::numeric_limits<uint64_t>::max();
-
-    check(_vkTable.vkWaitForFences(_device, 1, &_inFlightFences[_currentFrame], VK_TRUE, max));
-    check(_vkTable.vkResetFences(_device, 1, &_inFlightFences[_currentFrame]));
+    // The slot of this frame is free once the GPU has finished the frame that used it _framesInFlight frames ago
+    VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &_frameTimeline;
+    waitInfo.pValues        = &_frameTimelineValues[_currentFrame];
+    check(_vkTable.vkWaitSemaphores(_device, &waitInfo, std::numeric_limits<uint64_t>::max()));
 
     const auto result = _vkTable.vkAcquireNextImageKHR(_device,
                                                        _swapchain,
@@ -188,31 +210,30 @@ bool Device::newFrame() {
     }
 
     check(_vkTable.vkResetDescriptorPool(_device, _descriptorPools[_currentFrame], {}));
-    decltype(_freeDescriptorSetQueue) saveDescriptorSets{};
-    std::vector<VkDescriptorSet> freeDescriptorSets{};
-    saveDescriptorSets.reserve(_freeDescriptorSetQueue.size());
-    freeDescriptorSets.reserve(_freeDescriptorSetQueue.size());
-    for (const auto& [descriptorSet, frame] : _freeDescriptorSetQueue) {
-        if (_absoluteFrame - frame >= kMaxFrames) {
-            freeDescriptorSets.push_back(descriptorSet);
-        } else {
-            saveDescriptorSets.emplace_back(descriptorSet, frame);
+
+    // The queues are filtered in place and the scratch list keeps its capacity, so a frame does not allocate here
+    _freeDescriptorSets.clear();
+    std::erase_if(_freeDescriptorSetQueue, [this](const auto& item) {
+        if (_absoluteFrame - item.second >= _framesInFlight) {
+            _freeDescriptorSets.push_back(item.first);
+            return true;
         }
-    }
-    if (!freeDescriptorSets.empty()) {
+        return false;
+    });
+    if (!_freeDescriptorSets.empty()) {
         check(_vkTable.vkFreeDescriptorSets(
-            _device, _globalDescriptorPool, (uint32_t) freeDescriptorSets.size(), freeDescriptorSets.data()));
+            _device, _globalDescriptorPool, (uint32_t) _freeDescriptorSets.size(), _freeDescriptorSets.data()));
     }
-    _freeDescriptorSetQueue = std::move(saveDescriptorSets);
 
-    auto unusedImageViews = std::move(_unusedImageViews);
-    for (auto [frame, view] : unusedImageViews) {
-        if (_absoluteFrame - frame >= 2) {
-            _vkTable.vkDestroyImageView(_device, view, getAllocCalls());
-        } else {
-            _unusedImageViews.emplace_back(frame, view);
+    std::erase_if(_unusedImageViews, [this](const auto& item) {
+        if (_absoluteFrame - item.first >= _framesInFlight) {
+            _vkTable.vkDestroyImageView(_device, item.second, getAllocCalls());
+            return true;
         }
-    }
+        return false;
+    });
+
+    defragment();
     return true;
 }
 
@@ -222,6 +243,8 @@ void Device::submit(CommandBuffer* commandBuffer) {
 }
 
 void Device::present() {
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_DEVICE);
+
     submit(_frameCommandBuffer);
 
     _frameCommandBuffer = nullptr;
@@ -236,17 +259,30 @@ void Device::present() {
 
     VkSemaphore waitSemaphores[]      = { _imageAvailableSemaphores[_currentFrame] };
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-    VkSemaphore signalSemaphores[]    = { _renderFinishedSemaphores[_currentFrame] };
+    VkSemaphore signalSemaphores[]    = { _renderFinishedSemaphores[_currentFrame], _frameTimeline };
+    gerium_uint64_t waitValues[]      = { 0 };
+    gerium_uint64_t signalValues[]    = { 0, _frameTimelineValue };
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineInfo.waitSemaphoreValueCount   = 1;
+    timelineInfo.pWaitSemaphoreValues      = waitValues;
+    timelineInfo.signalSemaphoreValueCount = 2;
+    timelineInfo.pSignalSemaphoreValues    = signalValues;
 
-    VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO, &timelineInfo };
     submitInfo.waitSemaphoreCount   = 1;
     submitInfo.pWaitSemaphores      = waitSemaphores;
     submitInfo.pWaitDstStageMask    = waitStages;
     submitInfo.commandBufferCount   = _numQueuedCommandBuffers;
     submitInfo.pCommandBuffers      = enqueuedCommandBuffers;
-    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.signalSemaphoreCount = 2;
     submitInfo.pSignalSemaphores    = signalSemaphores;
-    check(_vkTable.vkQueueSubmit(_queueGraphic, 1, &submitInfo, _inFlightFences[_currentFrame]));
+    if (_profilerEnabled) {
+        _profiler->traceInstant("queue_submit");
+    }
+    check(_vkTable.vkQueueSubmit(_queueGraphic, 1, &submitInfo, VK_NULL_HANDLE));
+
+    _frameTimelineValues[_currentFrame] = _frameTimelineValue++;
 
     VkPresentInfoKHR presentInfo{ VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
     presentInfo.waitSemaphoreCount = 1;
@@ -256,6 +292,9 @@ void Device::present() {
     presentInfo.pImageIndices      = &_swapchainImageIndex;
     presentInfo.pResults           = nullptr;
 
+    if (_profilerEnabled) {
+        _profiler->traceInstant("present");
+    }
     const auto result = _vkTable.vkQueuePresentKHR(_queuePresent, &presentInfo);
 
     _numQueuedCommandBuffers = 0;
@@ -266,7 +305,9 @@ void Device::present() {
     _finishedLoadTextures.clear();
 
     if (_profilerEnabled) {
+        AllocationScope profilerScope(GERIUM_ALLOCATION_SCOPE_PROFILER);
         _profiler->fetchDataFromGpu();
+        _profiler->endFrame();
     }
 
     vmaSetCurrentFrameIndex(_vmaAllocator, _currentFrame);
@@ -285,6 +326,7 @@ void Device::present() {
 
     frameCountersAdvance();
     deleteResources();
+    releaseRecycled();
 }
 
 BufferHandle Device::createBuffer(const BufferCreation& creation) {
@@ -292,12 +334,21 @@ BufferHandle Device::createBuffer(const BufferCreation& creation) {
 
     auto [handle, buffer] = _buffers.obtain_and_access();
 
-    buffer->vkUsageFlags = toVkBufferUsageFlags(creation.usageFlags);
-    buffer->usage        = creation.usage;
-    buffer->state        = ResourceState::Undefined;
-    buffer->size         = creation.size;
-    buffer->name         = intern(creation.name);
-    buffer->parent       = Undefined;
+    buffer->vkBuffer       = VK_NULL_HANDLE;
+    buffer->vmaAllocation  = VK_NULL_HANDLE;
+    buffer->vkUsageFlags   = toVkBufferUsageFlags(creation.usageFlags);
+    buffer->usage          = creation.usage;
+    buffer->state          = ResourceState::Undefined;
+    buffer->size           = creation.size;
+    buffer->name           = intern(creation.name);
+    buffer->parent         = Undefined;
+    buffer->globalOffset   = 0;
+    buffer->mappedData     = nullptr;
+    buffer->lastUsedFrame  = _absoluteFrame;
+    buffer->heapBlock      = VK_NULL_HANDLE;
+    buffer->heapAllocation = VK_NULL_HANDLE;
+    buffer->memoryCategory = calcMemoryCategory(creation);
+    buffer->memorySize     = 0;
 
     constexpr auto dynamicBufferFlags = GERIUM_BUFFER_USAGE_VERTEX_BIT | GERIUM_BUFFER_USAGE_INDEX_BIT |
                                         GERIUM_BUFFER_USAGE_UNIFORM_BIT | GERIUM_BUFFER_USAGE_STORAGE_BIT |
@@ -310,74 +361,112 @@ BufferHandle Device::createBuffer(const BufferCreation& creation) {
         return handle;
     }
 
-    const auto vkUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | buffer->vkUsageFlags;
+    // Small immutable buffers are ranges of shared heap blocks, so thousands of meshes and materials do not each get
+    // their own allocation. The range is addressed the same way as dynamic buffers: parent buffer and global offset
+    const auto useHeap = creation.usage == ResourceUsageType::Immutable && !creation.persistent &&
+                         creation.size <= kBufferHeapMaxSize;
+    if (useHeap) {
+        allocateFromHeap(handle);
+        buffer = _buffers.access(handle);
+    } else {
+        const auto vkUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | buffer->vkUsageFlags;
 
-    VmaAllocationCreateFlags vmaFlags;
-    switch (creation.usage) {
-        case ResourceUsageType::Immutable:
-            if (creation.initialData) {
-                vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-                           VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
-                           VMA_ALLOCATION_CREATE_MAPPED_BIT;
-            } else {
-                vmaFlags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+        VmaAllocationCreateFlags vmaFlags;
+        switch (creation.usage) {
+            case ResourceUsageType::Immutable:
+                if (creation.initialData) {
+                    vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                               VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT |
+                               VMA_ALLOCATION_CREATE_MAPPED_BIT;
+                } else {
+                    vmaFlags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+                    if (creation.persistent) {
+                        _logger->print(GERIUM_LOGGER_LEVEL_ERROR, "Unable to create a memory mapped immutable buffer");
+                        error(GERIUM_RESULT_ERROR_INVALID_ARGUMENT);
+                    }
+                }
+                break;
+            case ResourceUsageType::Staging:
+                vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+                if (creation.persistent) {
+                    vmaFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+                }
+                break;
+            case ResourceUsageType::Readback:
+                vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
                 if (creation.persistent) {
-                    _logger->print(GERIUM_LOGGER_LEVEL_ERROR, "Unable to create a memory mapped immutable buffer");
-                    error(GERIUM_RESULT_ERROR_INVALID_ARGUMENT);
+                    vmaFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
                 }
+                break;
+            default:
+                assert(!"unreachable code");
+                break;
+        }
+
+        VkBufferCreateInfo bufferCreateInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferCreateInfo.size                  = creation.size;
+        bufferCreateInfo.usage                 = vkUsage;
+        bufferCreateInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+        bufferCreateInfo.queueFamilyIndexCount = 0;
+        bufferCreateInfo.pQueueFamilyIndices   = nullptr;
+
+        // Within the budget VMA falls back to other memory types (host memory over PCIe) when the preferred heap is
+        // full, allocating past the budget is only the last resort
+        VmaAllocationCreateInfo allocationCreateInfo;
+        allocationCreateInfo.flags          = vmaFlags | VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT;
+        allocationCreateInfo.usage          = VMA_MEMORY_USAGE_AUTO;
+        allocationCreateInfo.requiredFlags  = 0;
+        allocationCreateInfo.preferredFlags = 0;
+        allocationCreateInfo.memoryTypeBits = 0;
+        allocationCreateInfo.pool           = VK_NULL_HANDLE;
+        allocationCreateInfo.pUserData      = VK_NULL_HANDLE;
+        allocationCreateInfo.priority       = 0.0f;
+
+        const auto key = calcRecycleKey(buffer->vkUsageFlags, creation.usage, creation.size, creation.persistent);
+        if (!reuseBuffer(key, *buffer)) {
+            VmaAllocationInfo allocationInfo{};
+
+            auto createBuffer = [&]() {
+                return vmaCreateBuffer(_vmaAllocator,
+                                       &bufferCreateInfo,
+                                       &allocationCreateInfo,
+                                       &buffer->vkBuffer,
+                                       &buffer->vmaAllocation,
+                                       &allocationInfo);
+            };
+
+            auto result = createBuffer();
+            if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY && releaseRecycled(true)) {
+                result = createBuffer();
             }
-            break;
-        case ResourceUsageType::Staging:
-            vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
-            if (creation.persistent) {
-                vmaFlags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY) {
+                _logger->print(GERIUM_LOGGER_LEVEL_WARNING, "Memory budget exceeded, allocating buffer over budget");
+                allocationCreateInfo.flags = vmaFlags;
+                result                     = createBuffer();
             }
-            break;
-        default:
-            assert(!"unreachable code");
-            break;
-    }
-
-    VkBufferCreateInfo bufferCreateInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-    bufferCreateInfo.size                  = creation.size;
-    bufferCreateInfo.usage                 = vkUsage;
-    bufferCreateInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-    bufferCreateInfo.queueFamilyIndexCount = 0;
-    bufferCreateInfo.pQueueFamilyIndices   = nullptr;
-
-    VmaAllocationCreateInfo allocationCreateInfo;
-    allocationCreateInfo.flags          = vmaFlags;
-    allocationCreateInfo.usage          = VMA_MEMORY_USAGE_AUTO;
-    allocationCreateInfo.requiredFlags  = 0;
-    allocationCreateInfo.preferredFlags = 0;
-    allocationCreateInfo.memoryTypeBits = 0;
-    allocationCreateInfo.pool           = VK_NULL_HANDLE;
-    allocationCreateInfo.pUserData      = VK_NULL_HANDLE;
-    allocationCreateInfo.priority       = 0.0f;
+            check(result);
+            buffer->vkDeviceMemory = allocationInfo.deviceMemory;
 
-    VmaAllocationInfo allocationInfo{};
-
-    check(vmaCreateBuffer(_vmaAllocator,
-                          &bufferCreateInfo,
-                          &allocationCreateInfo,
-                          &buffer->vkBuffer,
-                          &buffer->vmaAllocation,
-                          &allocationInfo));
-    buffer->vkDeviceMemory = allocationInfo.deviceMemory;
+            if (creation.persistent) {
+                buffer->mappedData = static_cast<uint8_t*>(allocationInfo.pMappedData);
+            }
+        }
 
-    if (_enableDebugNames && buffer->name) {
-        vmaSetAllocationName(_vmaAllocator, buffer->vmaAllocation, buffer->name);
-    }
+        buffer->memorySize = allocationSize(buffer->vmaAllocation);
+        trackMemory(buffer->memoryCategory, buffer->memorySize, true);
 
-    setObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t) buffer->vkBuffer, buffer->name);
+        if (_enableDebugNames && buffer->name) {
+            vmaSetAllocationName(_vmaAllocator, buffer->vmaAllocation, buffer->name);
+        }
 
-    if (creation.persistent) {
-        buffer->mappedData = static_cast<uint8_t*>(allocationInfo.pMappedData);
+        setObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t) buffer->vkBuffer, buffer->name);
     }
 
     if (creation.initialData || creation.hasFillValue) {
-        VkMemoryPropertyFlags memPropFlags;
-        vmaGetAllocationMemoryProperties(_vmaAllocator, buffer->vmaAllocation, &memPropFlags);
+        VkMemoryPropertyFlags memPropFlags{};
+        if (!useHeap) {
+            vmaGetAllocationMemoryProperties(_vmaAllocator, buffer->vmaAllocation, &memPropFlags);
+        }
 
         auto fill = [&creation](void* data) {
             auto ptr = (gerium_uint32_t*) data;
@@ -403,6 +492,10 @@ BufferHandle Device::createBuffer(const BufferCreation& creation) {
                 unmapBuffer(handle);
             }
         } else if (creation.initialData) {
+            ProfilerEvent uploadEvent(buffer->size >= kLargeUploadSize ? _profiler.get() : nullptr,
+                                      GERIUM_HITCH_CAUSE_LARGE_UPLOAD,
+                                      buffer->name);
+
             BufferCreation stagingCreation{};
             stagingCreation.set(GERIUM_BUFFER_USAGE_STORAGE_BIT, ResourceUsageType::Dynamic, buffer->size);
             auto stagingBuffer = createBuffer(stagingCreation);
@@ -436,56 +529,50 @@ TextureHandle Device::createTexture(const TextureCreation& creation) {
     texture->type          = creation.type;
     texture->name          = intern(creation.name);
     texture->parentTexture = Undefined;
-    texture->sampler       = Undefined;
-
-    auto imageFlags =
-        creation.type == GERIUM_TEXTURE_TYPE_CUBE ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : VkImageCreateFlags{};
-
-    VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT;
-
-    if ((creation.flags & TextureFlags::Compute) == TextureFlags::Compute) {
-        usage |= VK_IMAGE_USAGE_STORAGE_BIT;
-    }
+    texture->sampler        = Undefined;
+    texture->lastUsedFrame  = _absoluteFrame;
+    texture->memoryCategory = calcMemoryCategory(creation.flags);
+    texture->memorySize     = 0;
 
-    if (hasDepthOrStencil(texture->vkFormat)) {
-        usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    } else {
-        const auto renderTarget = (creation.flags & TextureFlags::RenderTarget) == TextureFlags::RenderTarget;
-        usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-        usage |= renderTarget ? VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT : 0;
-    }
-
-    VkImageCreateInfo imageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
-    imageInfo.flags                 = imageFlags;
-    imageInfo.imageType             = toVkImageType(creation.type);
-    imageInfo.format                = texture->vkFormat;
-    imageInfo.extent.width          = texture->width;
-    imageInfo.extent.height         = texture->height;
-    imageInfo.extent.depth          = texture->depth;
-    imageInfo.mipLevels             = texture->mipLevels;
-    imageInfo.arrayLayers           = texture->layers;
-    imageInfo.samples               = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.tiling                = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.usage                 = usage;
-    imageInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-    imageInfo.queueFamilyIndexCount = 0;
-    imageInfo.pQueueFamilyIndices   = nullptr;
-    imageInfo.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+    const auto imageInfo = getImageCreateInfo(*texture);
 
     if (creation.alias == Undefined) {
-        VmaAllocationCreateInfo memoryInfo{};
-        memoryInfo.flags          = VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT;
-        memoryInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-
-        check(vmaCreateImage(
-            _vmaAllocator, &imageInfo, &memoryInfo, &texture->vkImage, &texture->vmaAllocation, nullptr));
+        if (!reuseTexture(imageInfo, *texture)) {
+            VmaAllocationCreateInfo memoryInfo{};
+            memoryInfo.flags          = VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT | VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT;
+            memoryInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+            auto createImage = [&]() {
+                return vmaCreateImage(
+                    _vmaAllocator, &imageInfo, &memoryInfo, &texture->vkImage, &texture->vmaAllocation, nullptr);
+            };
+
+            auto result = createImage();
+            if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY && releaseRecycled(true)) {
+                result = createImage();
+            }
+            if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY) {
+                _logger->print(GERIUM_LOGGER_LEVEL_WARNING, "Memory budget exceeded, allocating texture over budget");
+                memoryInfo.flags = VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT;
+                result           = createImage();
+            }
+            check(result);
+        }
 
         if (_enableDebugNames && texture->name) {
             vmaSetAllocationName(_vmaAllocator, texture->vmaAllocation, texture->name);
         }
+
+        texture->memorySize = allocationSize(texture->vmaAllocation);
+        trackMemory(texture->memoryCategory, texture->memorySize, true);
     } else {
         auto aliasTexture = _textures.access(creation.alias);
         check(vmaCreateAliasingImage(_vmaAllocator, aliasTexture->vmaAllocation, &imageInfo, &texture->vkImage));
+        texture->vmaAllocation = VK_NULL_HANDLE;
+
+        // The image lives in the memory of a texture released earlier in the frame, what it would have cost on its
+        // own is the saving of the frame graph aliasing
+        trackAliasedMemory(texture->memoryCategory, texture->size, true);
     }
 
     setObjectName(VK_OBJECT_TYPE_IMAGE, (uint64_t) texture->vkImage, texture->name);
@@ -598,7 +685,12 @@ RenderPassHandle Device::createRenderPass(const RenderPassCreation& creation) {
 
     renderPass->output       = creation.output;
     renderPass->name         = intern(creation.name);
-    renderPass->vkRenderPass = vkCreateRenderPass(renderPass->output, renderPass->name);
+    renderPass->vkRenderPass = VK_NULL_HANDLE;
+
+    // With dynamic rendering a render pass only describes the formats and operations of the attachments
+    if (!_dynamicRenderingSupported) {
+        renderPass->vkRenderPass = vkCreateRenderPass(renderPass->output, renderPass->name);
+    }
 
     _renderPassCache[key] = handle;
     return handle;
@@ -641,6 +733,12 @@ FramebufferHandle Device::createFramebuffer(const FramebufferCreation& creation)
         framebufferAttachments[activeAttachments++] = texture->vkImageView;
     }
 
+    // With dynamic rendering the attachments are passed to vkCmdBeginRenderingKHR, the framebuffer only keeps them
+    if (_dynamicRenderingSupported) {
+        framebuffer->vkFramebuffer = VK_NULL_HANDLE;
+        return handle;
+    }
+
     auto renderPass = _renderPasses.access(framebuffer->renderPass);
 
     VkFramebufferCreateInfo createInfo{ VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO };
@@ -850,6 +948,9 @@ ProgramHandle Device::createProgram(const ProgramCreation& creation, bool saveSp
 }
 
 PipelineHandle Device::createPipeline(const PipelineCreation& creation) {
+    ProfilerScope scope(_profiler.get(), "create_pipeline");
+    ProfilerEvent event(_profiler.get(), GERIUM_HITCH_CAUSE_PIPELINE_CREATION, creation.name);
+
     auto pc = creation;
     std::vector<std::unique_ptr<gerium_uint8_t[]>> files;
 
@@ -988,10 +1089,14 @@ PipelineHandle Device::createPipeline(const PipelineCreation& creation) {
     pipeline->numActiveLayouts = numActiveLayouts;
 
     if (program->graphicsPipeline) {
-        RenderPassCreation rc{};
-        rc.output             = pc.renderPass;
-        rc.name               = pc.name;
-        pipeline->renderPass  = createRenderPass(rc);
+        if (!_dynamicRenderingSupported) {
+            RenderPassCreation rc{};
+            rc.output            = pc.renderPass;
+            rc.name              = pc.name;
+            pipeline->renderPass = createRenderPass(rc);
+        } else {
+            pipeline->renderPass = Undefined;
+        }
         pipeline->vkBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
         VkPipelineVertexInputStateCreateInfo vertexInput{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
@@ -1155,7 +1260,20 @@ PipelineHandle Device::createPipeline(const PipelineCreation& creation) {
         pipelineInfo.pColorBlendState    = &colorBlending;
         pipelineInfo.pDynamicState       = &dynamicState;
         pipelineInfo.layout              = pipelineLayout;
-        pipelineInfo.renderPass          = _renderPasses.access(pipeline->renderPass)->vkRenderPass;
+
+        const auto depthFormat = pc.renderPass.depthStencilFormat;
+
+        VkPipelineRenderingCreateInfoKHR renderingInfo{ VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR };
+        renderingInfo.colorAttachmentCount    = pc.renderPass.numColorFormats;
+        renderingInfo.pColorAttachmentFormats = pc.renderPass.colorFormats;
+        renderingInfo.depthAttachmentFormat   = hasDepth(depthFormat) ? depthFormat : VK_FORMAT_UNDEFINED;
+        renderingInfo.stencilAttachmentFormat = hasStencil(depthFormat) ? depthFormat : VK_FORMAT_UNDEFINED;
+
+        if (_dynamicRenderingSupported) {
+            pipelineInfo.pNext = &renderingInfo;
+        } else {
+            pipelineInfo.renderPass = _renderPasses.access(pipeline->renderPass)->vkRenderPass;
+        }
 
         check(_vkTable.vkCreateGraphicsPipelines(
             _device, pipelineCache, 1, &pipelineInfo, getAllocCalls(), &pipeline->vkPipeline));
@@ -1216,39 +1334,39 @@ PipelineHandle Device::createPipeline(const PipelineCreation& creation) {
 }
 
 void Device::destroyBuffer(BufferHandle handle) {
-    _deletionQueue.push({ ResourceType::Buffer, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::Buffer)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroyTexture(TextureHandle handle) {
-    _deletionQueue.push({ ResourceType::Texture, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::Texture)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroySampler(SamplerHandle handle) {
-    _deletionQueue.push({ ResourceType::Sampler, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::Sampler)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroyRenderPass(RenderPassHandle handle) {
-    _deletionQueue.push({ ResourceType::RenderPass, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::RenderPass)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroyFramebuffer(FramebufferHandle handle) {
-    _deletionQueue.push({ ResourceType::Framebuffer, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::Framebuffer)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroyDescriptorSet(DescriptorSetHandle handle) {
-    _deletionQueue.push({ ResourceType::DescriptorSet, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::DescriptorSet)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroyDescriptorSetLayout(DescriptorSetLayoutHandle handle) {
-    _deletionQueue.push({ ResourceType::DescriptorSetLayout, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::DescriptorSetLayout)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroyProgram(ProgramHandle handle) {
-    _deletionQueue.push({ ResourceType::Program, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::Program)].push({ _frameTimelineValue, handle });
 }
 
 void Device::destroyPipeline(PipelineHandle handle) {
-    _deletionQueue.push({ ResourceType::Pipeline, _currentFrame, handle });
+    _deletionQueues[size_t(ResourceType::Pipeline)].push({ _frameTimelineValue, handle });
 }
 
 void* Device::mapBuffer(BufferHandle handle, uint32_t offset, uint32_t size) {
@@ -1263,6 +1381,7 @@ void* Device::mapBuffer(BufferHandle handle, uint32_t offset, uint32_t size) {
 
         uint8_t* mappedMemory = _dynamicUBOMapped + buffer->mappedOffset;
         _dynamicUBOAllocatedSize += size;
+        countDynamicBytes(size);
 
         assert(_dynamicUBOAllocatedSize < _dynamicUBOSize * (_currentFrame + 1));
 
@@ -1274,6 +1393,7 @@ void* Device::mapBuffer(BufferHandle handle, uint32_t offset, uint32_t size) {
 
         uint8_t* mappedMemory = _dynamicSSBOMapped + buffer->mappedOffset;
         _dynamicSSBOAllocatedSize += size;
+        countDynamicBytes(size);
 
         assert(_dynamicSSBOAllocatedSize < _dynamicSSBOSize * (_currentFrame + 1));
 
@@ -1286,6 +1406,10 @@ void* Device::mapBuffer(BufferHandle handle, uint32_t offset, uint32_t size) {
     buffer->mappedOffset = offset;
     buffer->mappedSize   = size;
 
+    if (buffer->usage == ResourceUsageType::Readback) {
+        check(vmaInvalidateAllocation(_vmaAllocator, buffer->vmaAllocation, offset, size));
+    }
+
     return (uint8_t*) data + offset;
 }
 
@@ -1325,6 +1449,84 @@ void Device::showViewMips(TextureHandle handle, uint8_t mip) {
     vkCreateImageView(vc, handle);
 }
 
+void Device::swapTextures(TextureHandle lhs, TextureHandle rhs) {
+    auto lhsTexture = _textures.access(lhs);
+    auto rhsTexture = _textures.access(rhs);
+
+    std::swap(lhsTexture->vkImage, rhsTexture->vkImage);
+    std::swap(lhsTexture->vkImageView, rhsTexture->vkImageView);
+    std::swap(lhsTexture->vmaAllocation, rhsTexture->vmaAllocation);
+    std::swap(lhsTexture->size, rhsTexture->size);
+    std::swap(lhsTexture->width, rhsTexture->width);
+    std::swap(lhsTexture->height, rhsTexture->height);
+    std::swap(lhsTexture->depth, rhsTexture->depth);
+    std::swap(lhsTexture->mipLevels, rhsTexture->mipLevels);
+    std::swap(lhsTexture->loadedMips, rhsTexture->loadedMips);
+    std::swap(lhsTexture->states, rhsTexture->states);
+
+    invalidateDescriptorSets(lhs);
+    invalidateDescriptorSets(rhs);
+}
+
+bool Device::demoteBuffer(BufferHandle handle) {
+    auto buffer = _buffers.access(handle);
+    if (buffer->parent != Undefined || buffer->heapBlock || buffer->usage != ResourceUsageType::Immutable ||
+        !isDeviceLocal(buffer->vmaAllocation)) {
+        return false;
+    }
+
+    VkBufferCreateInfo bufferCreateInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bufferCreateInfo.size  = buffer->size;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | buffer->vkUsageFlags;
+
+    VmaAllocationCreateInfo allocationCreateInfo{};
+    allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT | VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT;
+    allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+
+    // The copy lives in a temporary pool entry, so the regular copy path and deferred deletion can be used for it
+    auto [hostHandle, hostBuffer] = _buffers.obtain_and_access();
+    buffer                        = _buffers.access(handle);
+    *hostBuffer                   = *buffer;
+    hostBuffer->state             = ResourceState::Undefined;
+
+    VmaAllocationInfo allocationInfo{};
+    if (vmaCreateBuffer(_vmaAllocator,
+                        &bufferCreateInfo,
+                        &allocationCreateInfo,
+                        &hostBuffer->vkBuffer,
+                        &hostBuffer->vmaAllocation,
+                        &allocationInfo) != VK_SUCCESS) {
+        _buffers.release(hostHandle);
+        return false;
+    }
+    hostBuffer->vkDeviceMemory = allocationInfo.deviceMemory;
+
+    if (isDeviceLocal(hostBuffer->vmaAllocation)) {
+        vmaDestroyBuffer(_vmaAllocator, hostBuffer->vkBuffer, hostBuffer->vmaAllocation);
+        _buffers.release(hostHandle);
+        return false;
+    }
+
+    auto commandBuffer = getPrimaryCommandBuffer(false);
+    commandBuffer->copyBuffer(handle, hostHandle);
+    commandBuffer->addBufferBarrier(hostHandle, ResourceState::GenericRead);
+    submit(commandBuffer);
+
+    std::swap(buffer->vkBuffer, hostBuffer->vkBuffer);
+    std::swap(buffer->vmaAllocation, hostBuffer->vmaAllocation);
+    std::swap(buffer->vkDeviceMemory, hostBuffer->vkDeviceMemory);
+    std::swap(buffer->state, hostBuffer->state);
+
+    if (_enableDebugNames && buffer->name) {
+        vmaSetAllocationName(_vmaAllocator, buffer->vmaAllocation, buffer->name);
+    }
+    setObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t) buffer->vkBuffer, buffer->name);
+
+    invalidateDescriptorSets(handle);
+    destroyBuffer(hostHandle);
+    return true;
+}
+
 void Device::bind(DescriptorSetHandle handle,
                   gerium_uint16_t binding,
                   gerium_uint16_t element,
@@ -1356,6 +1558,7 @@ void Device::bind(DescriptorSetHandle handle,
                 item.resource      = internResourceInput;
                 item.previousFrame = fromPreviousFrame;
                 item.handle        = resource;
+                markUsed(it->descriptorType, resource);
                 VkWriteDescriptorSet descriptorWrite[1]{};
                 VkDescriptorBufferInfo bufferInfo[1]{};
                 VkDescriptorImageInfo imageInfo[1]{};
@@ -1394,9 +1597,9 @@ void Device::bind(DescriptorSetHandle handle,
     }
 }
 
-VkDescriptorSet Device::updateDescriptorSet(DescriptorSetHandle handle,
-                                            DescriptorSetLayoutHandle layoutHandle,
-                                            FrameGraph* frameGraph) {
+std::pair<VkDescriptorSet, bool> Device::updateDescriptorSet(DescriptorSetHandle handle,
+                                                             DescriptorSetLayoutHandle layoutHandle,
+                                                             FrameGraph* frameGraph) {
     auto descriptorSet = _descriptorSets.access(handle);
 
     marl::lock lock(_descriptorPoolMutex);
@@ -1424,6 +1627,11 @@ VkDescriptorSet Device::updateDescriptorSet(DescriptorSetHandle handle,
             }
         }
 
+        // Global sets outlive the frame, allocating them again from the global pool is the expensive path
+        ProfilerEvent allocateEvent(descriptorSet->global ? _profiler.get() : nullptr,
+                                    GERIUM_HITCH_CAUSE_DESCRIPTOR_ALLOCATION,
+                                    "global_descriptor_set");
+
         if (descriptorSet->vkDescriptorSet && descriptorSet->global) {
             _freeDescriptorSetQueue.emplace_back(descriptorSet->vkDescriptorSet, _absoluteFrame);
         }
@@ -1452,8 +1660,11 @@ VkDescriptorSet Device::updateDescriptorSet(DescriptorSetHandle handle,
         descriptorSet->changed = (updateRequired || swapToPrevResource) && !bindless;
     }
 
+    if (recreate || descriptorSet->absoluteFrame != _absoluteFrame) {
+        markUsed(*_descriptorSetLayouts.access(layoutHandle), *descriptorSet);
+    }
     descriptorSet->absoluteFrame = _absoluteFrame;
-    return descriptorSet->vkDescriptorSet;
+    return { descriptorSet->vkDescriptorSet, recreate };
 }
 
 CommandBuffer* Device::getPrimaryCommandBuffer(bool profile) {
@@ -1518,6 +1729,24 @@ gerium_uint64_t Device::calcKeyInputResource(gerium_utf8_t resource, bool fromPr
     return hash(fromPreviousFrame, key);
 }
 
+bool Device::calibrateTimestamps(gerium_uint64_t& gpuTimestamp, gerium_uint64_t& cpuTimestamp) {
+    if (!_calibratedTimestampsSupported) {
+        return false;
+    }
+
+    VkCalibratedTimestampInfoEXT infos[2] = {
+        { VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, nullptr, VK_TIME_DOMAIN_DEVICE_EXT          },
+        { VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, nullptr, VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT }
+    };
+    gerium_uint64_t timestamps[2];
+    gerium_uint64_t maxDeviation;
+    check(_vkTable.vkGetCalibratedTimestampsEXT(_device, 2, infos, timestamps, &maxDeviation));
+
+    gpuTimestamp = timestamps[0];
+    cpuTimestamp = timestamps[1];
+    return true;
+}
+
 bool Device::isSupportedFormat(gerium_format_t format) noexcept {
     const auto vkFormat = toVkFormat(format);
 
@@ -1548,6 +1777,82 @@ uint32_t Device::totalMemoryUsed() {
     return total;
 }
 
+void Device::getMemoryStats(std::vector<gerium_memory_stats_t>& memoryStats) const {
+    memoryStats.resize(kMemoryCategoryCount);
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i) {
+        memoryStats[i]          = _memoryStats[i];
+        memoryStats[i].category = gerium_memory_category_t(i);
+    }
+}
+
+void Device::getMemoryBudget(gerium_uint64_t& budget, gerium_uint64_t& usage) {
+    if (_vmaBudget.size() != _deviceMemProperties.memoryHeapCount) {
+        _vmaBudget.resize(_deviceMemProperties.memoryHeapCount);
+    }
+    vmaGetHeapBudgets(_vmaAllocator, _vmaBudget.data());
+
+    budget = 0;
+    usage  = 0;
+    for (uint32_t i = 0; i < _deviceMemProperties.memoryHeapCount; ++i) {
+        if (_deviceMemProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            budget += _vmaBudget[i].budget;
+            usage += _vmaBudget[i].usage;
+        }
+    }
+}
+
+gerium_uint64_t Device::getTextureMemory(TextureHandle handle) const noexcept {
+    auto texture = _textures.access(handle);
+    if (!texture->vmaAllocation) {
+        return 0;
+    }
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(_vmaAllocator, texture->vmaAllocation, &info);
+    return info.size;
+}
+
+void Device::getEvictionCandidates(gerium_uint32_t minIdleFrames, std::vector<gerium_eviction_t>& candidates) {
+    VmaAllocationInfo info;
+
+    for (auto texture : _textures) {
+        const auto renderTarget = (texture->flags & TextureFlags::RenderTarget) == TextureFlags::RenderTarget;
+        if (!texture->vmaAllocation || texture->parentTexture != Undefined || renderTarget ||
+            _absoluteFrame - texture->lastUsedFrame < minIdleFrames || !isDeviceLocal(texture->vmaAllocation)) {
+            continue;
+        }
+        vmaGetAllocationInfo(_vmaAllocator, texture->vmaAllocation, &info);
+
+        gerium_eviction_t candidate{};
+        candidate.type        = GERIUM_RESOURCE_TYPE_TEXTURE;
+        candidate.buffer      = { Undefined.index };
+        candidate.texture     = { _textures.handle(texture).index };
+        candidate.size        = info.size;
+        candidate.idle_frames = _absoluteFrame - texture->lastUsedFrame;
+        candidates.push_back(candidate);
+    }
+
+    for (auto buffer : _buffers) {
+        // Heap blocks are shared by many small buffers whose use is not tracked, they are never evicted
+        if (buffer->parent != Undefined || buffer->heapBlock || buffer->usage != ResourceUsageType::Immutable ||
+            _absoluteFrame - buffer->lastUsedFrame < minIdleFrames || !isDeviceLocal(buffer->vmaAllocation)) {
+            continue;
+        }
+        vmaGetAllocationInfo(_vmaAllocator, buffer->vmaAllocation, &info);
+
+        gerium_eviction_t candidate{};
+        candidate.type        = GERIUM_RESOURCE_TYPE_BUFFER;
+        candidate.buffer      = { _buffers.handle(buffer).index };
+        candidate.texture     = { Undefined.index };
+        candidate.size        = info.size;
+        candidate.idle_frames = _absoluteFrame - buffer->lastUsedFrame;
+        candidates.push_back(candidate);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.idle_frames != rhs.idle_frames ? lhs.idle_frames > rhs.idle_frames : lhs.size > rhs.size;
+    });
+}
+
 void Device::createInstance(gerium_utf8_t appName, gerium_uint32_t version) {
 #if VULKAN_HPP_ENABLE_DYNAMIC_LOADER_TOOL != 0
     _vkTable.init();
@@ -1655,6 +1960,19 @@ void Device::createDevice(gerium_uint32_t threadCount, gerium_feature_flags_t fe
 
     _8BitStorageSupported = (featureFlags & GERIUM_FEATURE_8_BIT_STORAGE_BIT) == GERIUM_FEATURE_8_BIT_STORAGE_BIT;
 
+    _dynamicRenderingSupported = contains(extensions, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+    _calibratedTimestampsSupported = contains(extensions, VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+    if (_calibratedTimestampsSupported) {
+        // GPU timestamps are placed on the timeline of the CPU profiler (steady_clock), which is CLOCK_MONOTONIC
+        uint32_t domainCount = 0;
+        check(_vkTable.vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(_physicalDevice, &domainCount, nullptr));
+        std::vector<VkTimeDomainEXT> domains(domainCount);
+        check(_vkTable.vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(_physicalDevice, &domainCount, domains.data()));
+        _calibratedTimestampsSupported = contains(domains, VK_TIME_DOMAIN_DEVICE_EXT) &&
+                                         contains(domains, VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT);
+    }
+
     size_t queueCreateInfoCount                 = 0;
     VkDeviceQueueCreateInfo queueCreateInfos[4] = {};
 
@@ -1703,6 +2021,14 @@ void Device::createDevice(gerium_uint32_t threadCount, gerium_feature_flags_t fe
         pNext                    = &meshShaderFeatures;
     }
 
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR
+    };
+    if (_dynamicRenderingSupported) {
+        dynamicRenderingFeatures.pNext = pNext;
+        pNext                          = &dynamicRenderingFeatures;
+    }
+
     VkPhysicalDeviceFeatures2 deviceFeatures{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, pNext };
     _vkTable.vkGetPhysicalDeviceFeatures2(_physicalDevice, &deviceFeatures);
 
@@ -1718,6 +2044,7 @@ void Device::createDevice(gerium_uint32_t threadCount, gerium_feature_flags_t fe
     _16BitStorageSupported = (featureFlags & GERIUM_FEATURE_16_BIT_STORAGE_BIT) == GERIUM_FEATURE_16_BIT_STORAGE_BIT &&
                              testFeatures11.storageBuffer16BitAccess &&
                              testFeatures11.uniformAndStorageBuffer16BitAccess && deviceFeatures.features.shaderInt16;
+    _dynamicRenderingSupported = _dynamicRenderingSupported && dynamicRenderingFeatures.dynamicRendering;
 
     meshShaderFeatures.pNext = nullptr;
 
@@ -1740,6 +2067,7 @@ void Device::createDevice(gerium_uint32_t threadCount, gerium_feature_flags_t fe
             : false;
 
     features12.samplerFilterMinmax = _samplerFilterMinmaxSupported ? VK_TRUE : VK_FALSE;
+    features12.timelineSemaphore   = VK_TRUE;
     features12.drawIndirectCount   = testFeatures12.drawIndirectCount;
     if (_bindlessSupported) {
         features12.shaderSampledImageArrayNonUniformIndexing = testFeatures12.shaderSampledImageArrayNonUniformIndexing;
@@ -1778,6 +2106,23 @@ void Device::createDevice(gerium_uint32_t threadCount, gerium_feature_flags_t fe
     features.features.textureCompressionASTC_LDR = deviceFeatures.features.textureCompressionASTC_LDR;
     features.features.textureCompressionBC       = deviceFeatures.features.textureCompressionBC;
     features.features.shaderInt16                = deviceFeatures.features.shaderInt16;
+    features.features.pipelineStatisticsQuery    = deviceFeatures.features.pipelineStatisticsQuery;
+    features.features.inheritedQueries           = deviceFeatures.features.inheritedQueries;
+
+    if (features.features.pipelineStatisticsQuery) {
+        _pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+                              VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+                              VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                              VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+                              VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                              VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+                              VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+        if (_meshShaderSupported && meshShaderFeatures.meshShaderQueries) {
+            _pipelineStatistics |= VK_QUERY_PIPELINE_STATISTIC_TASK_SHADER_INVOCATIONS_BIT_EXT |
+                                   VK_QUERY_PIPELINE_STATISTIC_MESH_SHADER_INVOCATIONS_BIT_EXT;
+        }
+    }
+    _inheritedQueriesSupported = features.features.inheritedQueries;
 
     if (features.features.textureCompressionETC2) {
         _compressions |= TextureCompressionFlags::ETC2;
@@ -1793,10 +2138,16 @@ void Device::createDevice(gerium_uint32_t threadCount, gerium_feature_flags_t fe
         meshShaderFeatures.pNext                                  = features11.pNext;
         meshShaderFeatures.multiviewMeshShader                    = VK_FALSE;
         meshShaderFeatures.primitiveFragmentShadingRateMeshShader = VK_FALSE;
-        meshShaderFeatures.meshShaderQueries                      = VK_FALSE;
+        meshShaderFeatures.meshShaderQueries                      = meshShaderFeatures.meshShaderQueries &&
+                                                                    features.features.pipelineStatisticsQuery;
         features11.pNext                                          = &meshShaderFeatures;
     }
 
+    if (_dynamicRenderingSupported) {
+        dynamicRenderingFeatures.pNext = features11.pNext;
+        features11.pNext               = &dynamicRenderingFeatures;
+    }
+
     VkDeviceCreateInfo createInfo{ VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
     createInfo.pNext                   = &features;
     createInfo.queueCreateInfoCount    = (uint32_t) queueCreateInfoCount;
@@ -1821,16 +2172,24 @@ void Device::createDevice(gerium_uint32_t threadCount, gerium_feature_flags_t fe
 void Device::createProfiler(uint16_t gpuTimeQueriesPerFrame) {
     if (_profilerSupported) {
         VkProfiler* profiler;
-        Object::create<VkProfiler>(profiler, *this, gpuTimeQueriesPerFrame, kMaxFrames);
+        Object::create<VkProfiler>(profiler, *this, gpuTimeQueriesPerFrame, _framesInFlight);
         _profiler = profiler;
+        _profiler->setEnabled(_profilerEnabled);
         profiler->destroy();
 
         VkQueryPoolCreateInfo createInfo{ VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
         createInfo.queryType          = VK_QUERY_TYPE_TIMESTAMP;
-        createInfo.queryCount         = gpuTimeQueriesPerFrame * 2 * kMaxFrames;
+        createInfo.queryCount         = gpuTimeQueriesPerFrame * 2 * _framesInFlight;
         createInfo.pipelineStatistics = 0;
         check(_vkTable.vkCreateQueryPool(_device, &createInfo, getAllocCalls(), &_queryPool));
 
+        if (_pipelineStatistics) {
+            createInfo.queryType          = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            createInfo.queryCount         = gpuTimeQueriesPerFrame * _framesInFlight;
+            createInfo.pipelineStatistics = _pipelineStatistics;
+            check(_vkTable.vkCreateQueryPool(_device, &createInfo, getAllocCalls(), &_statisticsQueryPool));
+        }
+
         _gpuFrequency = _deviceProperties.limits.timestampPeriod / (1'000'000.0);
     }
 }
@@ -1895,11 +2254,12 @@ void Device::createDynamicBuffers() {
         .set(GERIUM_BUFFER_USAGE_VERTEX_BIT | GERIUM_BUFFER_USAGE_INDEX_BIT | GERIUM_BUFFER_USAGE_UNIFORM_BIT |
                  GERIUM_BUFFER_USAGE_STORAGE_BIT | GERIUM_BUFFER_USAGE_INDIRECT_BIT,
              ResourceUsageType::Staging,
-             _dynamicUBOSize * kMaxFrames)
+             _dynamicUBOSize * _framesInFlight)
         .setPersistent(true)
         .setName("Dynamic_Persistent_UBO");
     _dynamicUBO       = createBuffer(bcUBO);
     _dynamicUBOMapped = (uint8_t*) _buffers.access(_dynamicUBO)->mappedData;
+    setMemoryCategory(_dynamicUBO, GERIUM_MEMORY_CATEGORY_DYNAMIC);
 
     _dynamicSSBOSize = align(1024 * 1024 * 256, _alignment);
 
@@ -1908,11 +2268,12 @@ void Device::createDynamicBuffers() {
         .set(GERIUM_BUFFER_USAGE_VERTEX_BIT | GERIUM_BUFFER_USAGE_INDEX_BIT | GERIUM_BUFFER_USAGE_STORAGE_BIT |
                  GERIUM_BUFFER_USAGE_INDIRECT_BIT,
              ResourceUsageType::Staging,
-             _dynamicSSBOSize * kMaxFrames)
+             _dynamicSSBOSize * _framesInFlight)
         .setPersistent(true)
         .setName("Dynamic_Persistent_SSBO");
     _dynamicSSBO       = createBuffer(bcSSBO);
     _dynamicSSBOMapped = (uint8_t*) _buffers.access(_dynamicSSBO)->mappedData;
+    setMemoryCategory(_dynamicSSBO, GERIUM_MEMORY_CATEGORY_DYNAMIC);
 }
 
 void Device::createDefaultSampler() {
@@ -1942,14 +2303,17 @@ void Device::createDefaultTexture() {
 void Device::createSynchronizations() {
     VkSemaphoreCreateInfo semaphoreInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
 
-    VkFenceCreateInfo fenceInfo{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
-    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-    for (uint32_t i = 0; i < kMaxFrames; ++i) {
+    for (uint32_t i = 0; i < _framesInFlight; ++i) {
         check(_vkTable.vkCreateSemaphore(_device, &semaphoreInfo, getAllocCalls(), &_imageAvailableSemaphores[i]));
         check(_vkTable.vkCreateSemaphore(_device, &semaphoreInfo, getAllocCalls(), &_renderFinishedSemaphores[i]));
-        check(_vkTable.vkCreateFence(_device, &fenceInfo, getAllocCalls(), &_inFlightFences[i]));
     }
+
+    VkSemaphoreTypeCreateInfo typeInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue  = 0;
+
+    semaphoreInfo.pNext = &typeInfo;
+    check(_vkTable.vkCreateSemaphore(_device, &semaphoreInfo, getAllocCalls(), &_frameTimeline));
 }
 
 void Device::createSwapchain(Application* application) {
@@ -2073,6 +2437,10 @@ void Device::createSwapchain(Application* application) {
 void Device::createImGui(Application* application) {
     auto renderPass = _renderPasses.access(_swapchainRenderPass)->vkRenderPass;
 
+    VkPipelineRenderingCreateInfoKHR renderingInfo{ VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR };
+    renderingInfo.colorAttachmentCount    = 1;
+    renderingInfo.pColorAttachmentFormats = &_swapchainFormat.format;
+
     VkDescriptorPoolSize poolSizes[] = {
         { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1000 }
     };
@@ -2104,9 +2472,11 @@ void Device::createImGui(Application* application) {
     initInfo.ImageCount          = (uint32_t) _swapchainFramebuffers.size();
     initInfo.MSAASamples         = VK_SAMPLE_COUNT_1_BIT;
     initInfo.Subpass             = 0;
-    initInfo.UseDynamicRendering = false;
+    initInfo.UseDynamicRendering = _dynamicRenderingSupported;
     initInfo.Allocator           = getAllocCalls();
     initInfo.CheckVkResultFn     = check;
+
+    initInfo.PipelineRenderingCreateInfo = renderingInfo;
     ImGui_ImplVulkan_Init(&initInfo);
 
     ImGuiIO& io            = ImGui::GetIO();
@@ -2151,6 +2521,8 @@ void Device::createFidelityFX() {
 }
 
 void Device::resizeSwapchain() {
+    ProfilerEvent event(_profiler.get(), GERIUM_HITCH_CAUSE_SWAPCHAIN_RECREATION, "swapchain");
+
     _vkTable.vkDeviceWaitIdle(_device);
 
     auto oldSwapchain = _swapchain;
@@ -2388,6 +2760,8 @@ std::vector<uint32_t> Device::compile(const char* code,
                                       const char* name,
                                       gerium_uint32_t numMacros,
                                       const gerium_macro_definition_t* macros) {
+    ProfilerEvent event(_profiler.get(), GERIUM_HITCH_CAUSE_SHADER_COMPILE, name);
+
     shaderc::Compiler compiler;
     shaderc::CompileOptions options;
 
@@ -2729,125 +3103,252 @@ void Device::vkCreateImageView(const TextureViewCreation& creation, TextureHandl
 }
 
 void Device::deleteResources(bool forceDelete) {
-    while (!_deletionQueue.empty()) {
-        const auto& resource = _deletionQueue.front();
-        if (resource.frame != _currentFrame && !forceDelete) {
-            break;
+    // Resources are destroyed once the GPU has completed the frame in which they were released. Each type keeps
+    // its own list ordered by timeline value, and the Vulkan objects of all expired entries are released together
+    const auto completed = forceDelete ? std::numeric_limits<gerium_uint64_t>::max() : completedTimelineValue();
+    auto pending         = true;
+
+    ProfilerEvent event(_profiler.get(), GERIUM_HITCH_CAUSE_DELETION_BURST, "deletion_queue");
+    gerium_uint32_t deleted = 0;
+    while (pending) {
+        pending = false;
+        for (size_t type = 0; type < kResourceTypeCount; ++type) {
+            auto& queue = _deletionQueues[type];
+            while (!queue.empty() && queue.front().timelineValue <= completed) {
+                const auto handle = queue.front().handle;
+                queue.pop();
+                deleteResource(ResourceType(type), handle);
+                ++deleted;
+            }
+            // Destroying a resource can release the resources it owns, which are deleted in the same call when forced
+            pending = pending || (forceDelete && !queue.empty());
         }
-        switch (resource.type) {
-            case ResourceType::Buffer:
-                if (_buffers.references(BufferHandle{ resource.handle }) == 1) {
-                    auto buffer = _buffers.access(resource.handle);
-                    if (buffer->parent == Undefined) {
-                        vmaDestroyBuffer(_vmaAllocator, buffer->vkBuffer, buffer->vmaAllocation);
-                    }
-                }
-                _buffers.release(resource.handle);
-                break;
-            case ResourceType::Texture:
-                if (_textures.references(TextureHandle{ resource.handle }) == 1) {
-                    auto texture = _textures.access(resource.handle);
-                    if (texture->sampler != Undefined) {
-                        destroySampler(texture->sampler);
-                    }
-                    if (texture->vkImageView) {
-                        _vkTable.vkDestroyImageView(_device, texture->vkImageView, getAllocCalls());
-                    }
-                    if (texture->vkImage && texture->vmaAllocation) {
-                        vmaDestroyImage(_vmaAllocator, texture->vkImage, texture->vmaAllocation);
-                    } else if (texture->vkImage && !_swapchainImages.contains(resource.handle) &&
-                               texture->parentTexture == Undefined) {
-                        _vkTable.vkDestroyImage(_device, texture->vkImage, getAllocCalls());
-                    } else {
-                        _swapchainImages.erase(TextureHandle{ resource.handle });
+    }
+    flushReleaseBatch(forceDelete);
+
+    // Only a burst is worth reporting, the few resources released every frame are not a cause of a hitch
+    if (deleted >= kDeletionBurstSize) {
+        event.setCount(deleted);
+    } else {
+        event.cancel();
+    }
+}
+
+void Device::deleteResource(ResourceType type, Handle handle) {
+    switch (type) {
+        case ResourceType::Buffer:
+            if (_buffers.references(BufferHandle{ handle }) == 1) {
+                auto buffer = _buffers.access(handle);
+                if (buffer->heapAllocation) {
+                    freeFromHeap(*buffer);
+                } else if (buffer->parent == Undefined) {
+                    if (buffer->heapBlock) {
+                        vmaClearVirtualBlock(buffer->heapBlock);
+                        vmaDestroyVirtualBlock(buffer->heapBlock);
+                        std::erase(_bufferHeap, BufferHandle{ handle });
                     }
-                    if (texture->parentTexture != Undefined) {
-                        destroyTexture(texture->parentTexture);
+                    trackMemory(buffer->memoryCategory, buffer->memorySize, false);
+                    if (abandonDefragmentationMove(buffer->vmaAllocation)) {
+                        _releaseBatch.buffers.push_back(buffer->vkBuffer);
+                    } else if (!recycleBuffer(*buffer)) {
+                        _releaseBatch.buffers.push_back(buffer->vkBuffer);
+                        _releaseBatch.allocations.push_back(buffer->vmaAllocation);
                     }
                 }
-                _textures.release(resource.handle);
-                break;
-            case ResourceType::Sampler:
-                if (_samplers.references(SamplerHandle{ resource.handle }) == 1) {
-                    auto sampler = _samplers.access(resource.handle);
-                    _samplerCache.erase(calcSamplerHash(
-                        SamplerCreation()
-                            .setMinMagMip(sampler->minFilter, sampler->magFilter, sampler->mipFilter)
-                            .setAddressModeUvw(sampler->addressModeU, sampler->addressModeV, sampler->addressModeW)));
-                    _vkTable.vkDestroySampler(_device, sampler->vkSampler, getAllocCalls());
+            }
+            _buffers.release(handle);
+            break;
+        case ResourceType::Texture:
+            if (_textures.references(TextureHandle{ handle }) == 1) {
+                auto texture = _textures.access(handle);
+                if (texture->sampler != Undefined) {
+                    destroySampler(texture->sampler);
                 }
-                _samplers.release(resource.handle);
-                break;
-            case ResourceType::RenderPass:
-                if (_renderPasses.references(RenderPassHandle{ resource.handle }) == 1) {
-                    auto renderPass = _renderPasses.access(resource.handle);
-                    _renderPassCache.erase(hash(renderPass->output));
-                    _vkTable.vkDestroyRenderPass(_device, renderPass->vkRenderPass, getAllocCalls());
+                if (texture->vkImageView) {
+                    _releaseBatch.imageViews.push_back(texture->vkImageView);
                 }
-                _renderPasses.release(resource.handle);
-                break;
-            case ResourceType::Framebuffer:
-                if (_framebuffers.references(FramebufferHandle{ resource.handle }) == 1) {
-                    auto framebuffer = _framebuffers.access(resource.handle);
-                    for (gerium_uint32_t i = 0; i < framebuffer->numColorAttachments; ++i) {
-                        destroyTexture(framebuffer->colorAttachments[i]);
-                    }
-                    if (framebuffer->depthStencilAttachment != Undefined) {
-                        destroyTexture(framebuffer->depthStencilAttachment);
+                if (texture->vkImage && texture->vmaAllocation) {
+                    trackMemory(texture->memoryCategory, texture->memorySize, false);
+                    if (abandonDefragmentationMove(texture->vmaAllocation)) {
+                        _releaseBatch.images.push_back(texture->vkImage);
+                    } else if (!recycleTexture(*texture)) {
+                        _releaseBatch.images.push_back(texture->vkImage);
+                        _releaseBatch.allocations.push_back(texture->vmaAllocation);
                     }
-                    if (framebuffer->renderPass != Undefined) {
-                        destroyRenderPass(framebuffer->renderPass);
-                    }
-                    _vkTable.vkDestroyFramebuffer(_device, framebuffer->vkFramebuffer, getAllocCalls());
+                } else if (texture->vkImage && !_swapchainImages.contains(handle) &&
+                           texture->parentTexture == Undefined) {
+                    trackAliasedMemory(texture->memoryCategory, texture->size, false);
+                    _releaseBatch.images.push_back(texture->vkImage);
+                } else {
+                    _swapchainImages.erase(TextureHandle{ handle });
                 }
-                _framebuffers.release(resource.handle);
-                break;
-            case ResourceType::Program:
-                if (_programs.references(ProgramHandle{ resource.handle }) == 1) {
-                    auto program = _programs.access(resource.handle);
-                    for (uint32_t i = 0; i < program->activeShaders; ++i) {
-                        if (program->shaderStageInfo[i].module) {
-                            _vkTable.vkDestroyShaderModule(
-                                _device, program->shaderStageInfo[i].module, getAllocCalls());
-                        }
-                    }
+                if (texture->parentTexture != Undefined) {
+                    destroyTexture(texture->parentTexture);
                 }
-                _programs.release(resource.handle);
-                break;
-            case ResourceType::DescriptorSet:
-                if (_descriptorSets.references(DescriptorSetHandle{ resource.handle }) == 1) {
-                    auto descriptorSet = _descriptorSets.access(resource.handle);
-                    if (descriptorSet->global && descriptorSet->vkDescriptorSet) {
-                        _vkTable.vkFreeDescriptorSets(
-                            _device, _globalDescriptorPool, 1, &descriptorSet->vkDescriptorSet);
-                    }
+            }
+            _textures.release(handle);
+            break;
+        case ResourceType::Sampler:
+            if (_samplers.references(SamplerHandle{ handle }) == 1) {
+                auto sampler = _samplers.access(handle);
+                _samplerCache.erase(calcSamplerHash(
+                    SamplerCreation()
+                        .setMinMagMip(sampler->minFilter, sampler->magFilter, sampler->mipFilter)
+                        .setAddressModeUvw(sampler->addressModeU, sampler->addressModeV, sampler->addressModeW)));
+                _releaseBatch.samplers.push_back(sampler->vkSampler);
+            }
+            _samplers.release(handle);
+            break;
+        case ResourceType::RenderPass:
+            if (_renderPasses.references(RenderPassHandle{ handle }) == 1) {
+                auto renderPass = _renderPasses.access(handle);
+                _renderPassCache.erase(hash(renderPass->output));
+                if (renderPass->vkRenderPass) {
+                    _releaseBatch.renderPasses.push_back(renderPass->vkRenderPass);
                 }
-                _descriptorSets.release(resource.handle);
-                break;
-            case ResourceType::DescriptorSetLayout:
-                if (_descriptorSetLayouts.references(DescriptorSetLayoutHandle{ resource.handle }) == 1) {
-                    auto layout = _descriptorSetLayouts.access(resource.handle);
-                    _vkTable.vkDestroyDescriptorSetLayout(_device, layout->vkDescriptorSetLayout, getAllocCalls());
+            }
+            _renderPasses.release(handle);
+            break;
+        case ResourceType::Framebuffer:
+            if (_framebuffers.references(FramebufferHandle{ handle }) == 1) {
+                auto framebuffer = _framebuffers.access(handle);
+                for (gerium_uint32_t i = 0; i < framebuffer->numColorAttachments; ++i) {
+                    destroyTexture(framebuffer->colorAttachments[i]);
                 }
-                _descriptorSetLayouts.release(resource.handle);
-                break;
-            case ResourceType::Pipeline:
-                if (_pipelines.references(PipelineHandle{ resource.handle }) == 1) {
-                    auto pipeline = _pipelines.access(resource.handle);
-                    _vkTable.vkDestroyPipelineLayout(_device, pipeline->vkPipelineLayout, getAllocCalls());
-                    _vkTable.vkDestroyPipeline(_device, pipeline->vkPipeline, getAllocCalls());
-                    for (uint32_t i = 0; i < pipeline->numActiveLayouts; ++i) {
-                        destroyDescriptorSetLayout(pipeline->descriptorSetLayoutHandles[i]);
-                    }
-                    if (pipeline->renderPass != Undefined) {
-                        destroyRenderPass(pipeline->renderPass);
+                if (framebuffer->depthStencilAttachment != Undefined) {
+                    destroyTexture(framebuffer->depthStencilAttachment);
+                }
+                if (framebuffer->renderPass != Undefined) {
+                    destroyRenderPass(framebuffer->renderPass);
+                }
+                if (framebuffer->vkFramebuffer) {
+                    _releaseBatch.framebuffers.push_back(framebuffer->vkFramebuffer);
+                }
+            }
+            _framebuffers.release(handle);
+            break;
+        case ResourceType::Program:
+            if (_programs.references(ProgramHandle{ handle }) == 1) {
+                auto program = _programs.access(handle);
+                for (uint32_t i = 0; i < program->activeShaders; ++i) {
+                    if (program->shaderStageInfo[i].module) {
+                        _releaseBatch.shaderModules.push_back(program->shaderStageInfo[i].module);
                     }
                 }
-                _pipelines.release(resource.handle);
-                break;
-        }
-        _deletionQueue.pop();
+            }
+            _programs.release(handle);
+            break;
+        case ResourceType::DescriptorSet:
+            if (_descriptorSets.references(DescriptorSetHandle{ handle }) == 1) {
+                auto descriptorSet = _descriptorSets.access(handle);
+                if (descriptorSet->global && descriptorSet->vkDescriptorSet) {
+                    _releaseBatch.descriptorSets.push_back(descriptorSet->vkDescriptorSet);
+                }
+            }
+            _descriptorSets.release(handle);
+            break;
+        case ResourceType::DescriptorSetLayout:
+            if (_descriptorSetLayouts.references(DescriptorSetLayoutHandle{ handle }) == 1) {
+                auto layout = _descriptorSetLayouts.access(handle);
+                _releaseBatch.descriptorSetLayouts.push_back(layout->vkDescriptorSetLayout);
+            }
+            _descriptorSetLayouts.release(handle);
+            break;
+        case ResourceType::Pipeline:
+            if (_pipelines.references(PipelineHandle{ handle }) == 1) {
+                auto pipeline = _pipelines.access(handle);
+                _releaseBatch.pipelineLayouts.push_back(pipeline->vkPipelineLayout);
+                _releaseBatch.pipelines.push_back(pipeline->vkPipeline);
+                for (uint32_t i = 0; i < pipeline->numActiveLayouts; ++i) {
+                    destroyDescriptorSetLayout(pipeline->descriptorSetLayoutHandles[i]);
+                }
+                if (pipeline->renderPass != Undefined) {
+                    destroyRenderPass(pipeline->renderPass);
+                }
+            }
+            _pipelines.release(handle);
+            break;
+    }
+}
+
+void Device::flushReleaseBatch(bool forceDelete) {
+    if (!_releaseBatch.descriptorSets.empty()) {
+        marl::lock lock(_descriptorPoolMutex);
+        _vkTable.vkFreeDescriptorSets(_device,
+                                      _globalDescriptorPool,
+                                      (uint32_t) _releaseBatch.descriptorSets.size(),
+                                      _releaseBatch.descriptorSets.data());
+        _releaseBatch.descriptorSets.clear();
+    }
+
+    const auto size = _releaseBatch.size();
+    if (!size) {
+        return;
+    }
+
+    // Large batches (e.g. a level unload) are released on a worker so they do not stall the frame. VMA must not
+    // free memory while a defragmentation pass moves it, so during defragmentation allocations are freed on this
+    // thread, and defragment does not start while a worker release is still running
+    if (!forceDelete && size >= kAsyncReleaseThreshold && !_defragmentationContext) {
+        _releaseGroup.add();
+        ++_pendingReleases;
+        marl::schedule([this, batch = std::move(_releaseBatch)]() mutable {
+            defer(_releaseGroup.done());
+            release(batch);
+            --_pendingReleases;
+        });
+        _releaseBatch = {};
+    } else {
+        release(_releaseBatch);
+    }
+}
+
+void Device::release(ReleaseBatch& batch) noexcept {
+    for (auto buffer : batch.buffers) {
+        _vkTable.vkDestroyBuffer(_device, buffer, getAllocCalls());
+    }
+    for (auto imageView : batch.imageViews) {
+        _vkTable.vkDestroyImageView(_device, imageView, getAllocCalls());
+    }
+    for (auto image : batch.images) {
+        _vkTable.vkDestroyImage(_device, image, getAllocCalls());
+    }
+    for (auto sampler : batch.samplers) {
+        _vkTable.vkDestroySampler(_device, sampler, getAllocCalls());
+    }
+    for (auto framebuffer : batch.framebuffers) {
+        _vkTable.vkDestroyFramebuffer(_device, framebuffer, getAllocCalls());
+    }
+    for (auto renderPass : batch.renderPasses) {
+        _vkTable.vkDestroyRenderPass(_device, renderPass, getAllocCalls());
     }
+    for (auto shaderModule : batch.shaderModules) {
+        _vkTable.vkDestroyShaderModule(_device, shaderModule, getAllocCalls());
+    }
+    for (auto pipeline : batch.pipelines) {
+        _vkTable.vkDestroyPipeline(_device, pipeline, getAllocCalls());
+    }
+    for (auto pipelineLayout : batch.pipelineLayouts) {
+        _vkTable.vkDestroyPipelineLayout(_device, pipelineLayout, getAllocCalls());
+    }
+    for (auto descriptorSetLayout : batch.descriptorSetLayouts) {
+        _vkTable.vkDestroyDescriptorSetLayout(_device, descriptorSetLayout, getAllocCalls());
+    }
+    if (!batch.allocations.empty()) {
+        vmaFreeMemoryPages(_vmaAllocator, batch.allocations.size(), batch.allocations.data());
+    }
+
+    batch.buffers.clear();
+    batch.images.clear();
+    batch.imageViews.clear();
+    batch.samplers.clear();
+    batch.renderPasses.clear();
+    batch.framebuffers.clear();
+    batch.shaderModules.clear();
+    batch.descriptorSetLayouts.clear();
+    batch.pipelineLayouts.clear();
+    batch.pipelines.clear();
+    batch.allocations.clear();
 }
 
 void Device::setObjectName(VkObjectType type, uint64_t handle, gerium_utf8_t name) {
@@ -2981,12 +3482,23 @@ Device::Swapchain Device::getSwapchain() {
 
 void Device::frameCountersAdvance() noexcept {
     _previousFrame = _currentFrame;
-    _currentFrame  = (_currentFrame + 1) % kMaxFrames;
+    _currentFrame  = (_currentFrame + 1) % _framesInFlight;
     ++_absoluteFrame;
 }
 
+gerium_uint64_t Device::completedTimelineValue() const {
+    gerium_uint64_t value;
+    check(_vkTable.vkGetSemaphoreCounterValue(_device, _frameTimeline, &value));
+    return value;
+}
+
 void Device::uploadTextureData(TextureHandle handle, gerium_cdata_t data) {
     auto texture = _textures.access(handle);
+
+    ProfilerEvent event(texture->size >= kLargeUploadSize ? _profiler.get() : nullptr,
+                        GERIUM_HITCH_CAUSE_LARGE_UPLOAD,
+                        texture->name);
+
     BufferCreation bc{};
     bc.set(GERIUM_BUFFER_USAGE_VERTEX_BIT, ResourceUsageType::Dynamic, texture->size);
 
@@ -3003,6 +3515,553 @@ void Device::uploadTextureData(TextureHandle handle, gerium_cdata_t data) {
     texture->loadedMips = texture->mipLevels;
 }
 
+void Device::markUsed(BufferHandle handle) noexcept {
+    auto buffer = _buffers.access(handle);
+    if (buffer->parent == Undefined) {
+        buffer->lastUsedFrame = _absoluteFrame;
+    }
+}
+
+void Device::countDynamicBytes(gerium_uint32_t size) noexcept {
+    if (_profilerEnabled) {
+        _profiler->addRenderCounter(Profiler::kNoCounterNode, &gerium_render_counters_t::dynamic_buffer_bytes, size);
+    }
+}
+
+void Device::markUsed(VkDescriptorType type, Handle resource) noexcept {
+    if (resource == Undefined) {
+        return;
+    }
+    switch (type) {
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            _textures.access(resource)->lastUsedFrame = _absoluteFrame;
+            break;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+            _buffers.access(resource)->lastUsedFrame = _absoluteFrame;
+            break;
+        default:
+            break;
+    }
+}
+
+void Device::markUsed(const DescriptorSetLayout& descriptorSetLayout, const DescriptorSet& descriptorSet) noexcept {
+    for (const auto& [_, item] : descriptorSet.bindings) {
+        auto it = std::find_if(descriptorSetLayout.data.bindings.cbegin(),
+                               descriptorSetLayout.data.bindings.cend(),
+                               [b = item.binding](const auto& binding) {
+            return binding.binding == b;
+        });
+        if (it != descriptorSetLayout.data.bindings.cend()) {
+            markUsed(it->descriptorType, item.handle);
+        }
+    }
+}
+
+void Device::invalidateDescriptorSets(Handle resource) noexcept {
+    // Global descriptor sets are only rewritten when something changes in them
+    for (auto descriptorSet : _descriptorSets) {
+        if (descriptorSet->global && !descriptorSet->changed) {
+            for (const auto& [_, item] : descriptorSet->bindings) {
+                if (item.handle == resource) {
+                    descriptorSet->changed = 1;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+VkImageCreateInfo Device::getImageCreateInfo(const Texture& texture) const noexcept {
+    auto imageFlags =
+        texture.type == GERIUM_TEXTURE_TYPE_CUBE ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : VkImageCreateFlags{};
+
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT;
+
+    if ((texture.flags & TextureFlags::Compute) == TextureFlags::Compute) {
+        usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    }
+
+    if (hasDepthOrStencil(texture.vkFormat)) {
+        usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    } else {
+        const auto renderTarget = (texture.flags & TextureFlags::RenderTarget) == TextureFlags::RenderTarget;
+        usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        usage |= renderTarget ? VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT : 0;
+    }
+
+    VkImageCreateInfo imageInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    imageInfo.flags                 = imageFlags;
+    imageInfo.imageType             = toVkImageType(texture.type);
+    imageInfo.format                = texture.vkFormat;
+    imageInfo.extent.width          = texture.width;
+    imageInfo.extent.height         = texture.height;
+    imageInfo.extent.depth          = texture.depth;
+    imageInfo.mipLevels             = texture.mipLevels;
+    imageInfo.arrayLayers           = texture.layers;
+    imageInfo.samples               = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling                = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage                 = usage;
+    imageInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.queueFamilyIndexCount = 0;
+    imageInfo.pQueueFamilyIndices   = nullptr;
+    imageInfo.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+    return imageInfo;
+}
+
+void Device::allocateFromHeap(BufferHandle handle) {
+    // The range is bound as a dynamic offset or as a vertex/index offset, both must respect these alignments
+    VmaVirtualAllocationCreateInfo allocationCreateInfo{};
+    allocationCreateInfo.size      = _buffers.access(handle)->size;
+    allocationCreateInfo.alignment = std::max(_alignment, 16U);
+
+    VmaVirtualAllocation allocation{};
+    VkDeviceSize offset{};
+
+    BufferHandle block = Undefined;
+    for (auto heap : _bufferHeap) {
+        auto heapBlock = _buffers.access(heap)->heapBlock;
+        if (vmaVirtualAllocate(heapBlock, &allocationCreateInfo, &allocation, &offset) == VK_SUCCESS) {
+            block = heap;
+            break;
+        }
+    }
+
+    if (block == Undefined) {
+        block = createHeapBlock();
+        check(vmaVirtualAllocate(_buffers.access(block)->heapBlock, &allocationCreateInfo, &allocation, &offset));
+    }
+
+    auto buffer            = _buffers.access(handle);
+    buffer->parent         = block;
+    buffer->globalOffset   = (gerium_uint32_t) offset;
+    buffer->heapAllocation = allocation;
+}
+
+BufferHandle Device::createHeapBlock() {
+    constexpr auto heapBufferFlags = GERIUM_BUFFER_USAGE_VERTEX_BIT | GERIUM_BUFFER_USAGE_INDEX_BIT |
+                                     GERIUM_BUFFER_USAGE_UNIFORM_BIT | GERIUM_BUFFER_USAGE_STORAGE_BIT |
+                                     GERIUM_BUFFER_USAGE_INDIRECT_BIT;
+
+    BufferCreation creation{};
+    creation.set(heapBufferFlags, ResourceUsageType::Immutable, kBufferHeapBlockSize).setName("gerium_buffer_heap");
+
+    auto handle = createBuffer(creation);
+    setMemoryCategory(handle, GERIUM_MEMORY_CATEGORY_BUFFER_HEAP);
+
+    VmaVirtualBlockCreateInfo blockCreateInfo{};
+    blockCreateInfo.size                 = kBufferHeapBlockSize;
+    blockCreateInfo.pAllocationCallbacks = getAllocCalls();
+    check(vmaCreateVirtualBlock(&blockCreateInfo, &_buffers.access(handle)->heapBlock));
+
+    _bufferHeap.push_back(handle);
+    return handle;
+}
+
+void Device::freeFromHeap(const Buffer& buffer) noexcept {
+    // Blocks are kept for the lifetime of the device, the next small buffers reuse the freed ranges
+    vmaVirtualFree(_buffers.access(buffer.parent)->heapBlock, buffer.heapAllocation);
+}
+
+bool Device::recycleTexture(const Texture& texture) {
+    if (texture.parentTexture != Undefined) {
+        return false;
+    }
+    const auto key = calcRecycleKey(getImageCreateInfo(texture));
+    _recycledTextures.emplace(key, RecycledTexture{ texture.vkImage, texture.vmaAllocation, _absoluteFrame });
+    trackMemory(GERIUM_MEMORY_CATEGORY_RECYCLED, texture.memorySize, true);
+    return true;
+}
+
+bool Device::recycleBuffer(const Buffer& buffer) {
+    if (buffer.heapBlock) {
+        return false;
+    }
+    const auto key = calcRecycleKey(buffer.vkUsageFlags, buffer.usage, buffer.size, buffer.mappedData != nullptr);
+    const RecycledBuffer recycled{
+        buffer.vkBuffer, buffer.vmaAllocation, buffer.vkDeviceMemory, buffer.mappedData, _absoluteFrame
+    };
+    _recycledBuffers.emplace(key, recycled);
+    trackMemory(GERIUM_MEMORY_CATEGORY_RECYCLED, buffer.memorySize, true);
+    return true;
+}
+
+bool Device::reuseTexture(const VkImageCreateInfo& imageInfo, Texture& texture) {
+    auto it = _recycledTextures.find(calcRecycleKey(imageInfo));
+    if (it == _recycledTextures.end()) {
+        return false;
+    }
+    texture.vkImage       = it->second.image;
+    texture.vmaAllocation = it->second.allocation;
+    trackMemory(GERIUM_MEMORY_CATEGORY_RECYCLED, allocationSize(texture.vmaAllocation), false);
+    _recycledTextures.erase(it);
+    return true;
+}
+
+bool Device::reuseBuffer(gerium_uint64_t key, Buffer& buffer) {
+    auto it = _recycledBuffers.find(key);
+    if (it == _recycledBuffers.end()) {
+        return false;
+    }
+    buffer.vkBuffer       = it->second.buffer;
+    buffer.vmaAllocation  = it->second.allocation;
+    buffer.vkDeviceMemory = it->second.deviceMemory;
+    buffer.mappedData     = it->second.mappedData;
+    trackMemory(GERIUM_MEMORY_CATEGORY_RECYCLED, allocationSize(buffer.vmaAllocation), false);
+    _recycledBuffers.erase(it);
+    return true;
+}
+
+bool Device::releaseRecycled(bool all) {
+    if (!all && (!_recycledTextures.empty() || !_recycledBuffers.empty())) {
+        // Cached memory is given back before the budget runs low enough for residency to start evicting
+        gerium_uint64_t budget, usage;
+        getMemoryBudget(budget, usage);
+        all = usage > gerium_uint64_t(budget * kRecycleBudgetRatio);
+    }
+
+    auto released = false;
+    for (auto it = _recycledTextures.begin(); it != _recycledTextures.end();) {
+        if (all || _absoluteFrame - it->second.frame >= kRecycleFrames) {
+            trackMemory(GERIUM_MEMORY_CATEGORY_RECYCLED, allocationSize(it->second.allocation), false);
+            vmaDestroyImage(_vmaAllocator, it->second.image, it->second.allocation);
+            it       = _recycledTextures.erase(it);
+            released = true;
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = _recycledBuffers.begin(); it != _recycledBuffers.end();) {
+        if (all || _absoluteFrame - it->second.frame >= kRecycleFrames) {
+            trackMemory(GERIUM_MEMORY_CATEGORY_RECYCLED, allocationSize(it->second.allocation), false);
+            vmaDestroyBuffer(_vmaAllocator, it->second.buffer, it->second.allocation);
+            it       = _recycledBuffers.erase(it);
+            released = true;
+        } else {
+            ++it;
+        }
+    }
+    return released;
+}
+
+gerium_uint64_t Device::calcRecycleKey(const VkImageCreateInfo& imageInfo) noexcept {
+    const gerium_uint32_t key[] = { imageInfo.flags,
+                                    gerium_uint32_t(imageInfo.imageType),
+                                    gerium_uint32_t(imageInfo.format),
+                                    imageInfo.extent.width,
+                                    imageInfo.extent.height,
+                                    imageInfo.extent.depth,
+                                    imageInfo.mipLevels,
+                                    imageInfo.arrayLayers,
+                                    imageInfo.usage };
+    return hash(key);
+}
+
+gerium_uint64_t Device::calcRecycleKey(VkBufferUsageFlags usageFlags,
+                                       ResourceUsageType usage,
+                                       gerium_uint32_t size,
+                                       bool persistent) noexcept {
+    const gerium_uint32_t key[] = { usageFlags, gerium_uint32_t(usage), size, gerium_uint32_t(persistent) };
+    return hash(key);
+}
+
+void Device::trackMemory(gerium_memory_category_t category, gerium_uint64_t size, bool allocated) noexcept {
+    auto& stats = _memoryStats[category];
+    if (allocated) {
+        stats.current_bytes += size;
+        stats.peak_bytes = std::max(stats.peak_bytes, stats.current_bytes);
+        ++stats.allocation_count;
+        stats.peak_allocation_count = std::max(stats.peak_allocation_count, stats.allocation_count);
+    } else {
+        assert(stats.current_bytes >= size && stats.allocation_count);
+        stats.current_bytes -= size;
+        --stats.allocation_count;
+    }
+}
+
+void Device::trackAliasedMemory(gerium_memory_category_t category, gerium_uint64_t size, bool aliased) noexcept {
+    auto& stats = _memoryStats[category];
+    if (aliased) {
+        stats.aliased_bytes += size;
+    } else {
+        assert(stats.aliased_bytes >= size);
+        stats.aliased_bytes -= size;
+    }
+}
+
+void Device::setMemoryCategory(BufferHandle handle, gerium_memory_category_t category) noexcept {
+    auto buffer = _buffers.access(handle);
+    trackMemory(buffer->memoryCategory, buffer->memorySize, false);
+    trackMemory(category, buffer->memorySize, true);
+    buffer->memoryCategory = category;
+}
+
+gerium_uint64_t Device::allocationSize(VmaAllocation allocation) const noexcept {
+    VmaAllocationInfo allocationInfo;
+    vmaGetAllocationInfo(_vmaAllocator, allocation, &allocationInfo);
+    return allocationInfo.size;
+}
+
+gerium_memory_category_t Device::calcMemoryCategory(const BufferCreation& creation) noexcept {
+    if (creation.usage == ResourceUsageType::Staging || creation.usage == ResourceUsageType::Readback) {
+        return GERIUM_MEMORY_CATEGORY_STAGING;
+    }
+    constexpr auto geometryFlags = GERIUM_BUFFER_USAGE_VERTEX_BIT | GERIUM_BUFFER_USAGE_INDEX_BIT;
+    if (gerium_uint32_t(creation.usageFlags & geometryFlags) != 0) {
+        return GERIUM_MEMORY_CATEGORY_GEOMETRY;
+    }
+    return GERIUM_MEMORY_CATEGORY_BUFFER;
+}
+
+gerium_memory_category_t Device::calcMemoryCategory(TextureFlags flags) noexcept {
+    if ((flags & TextureFlags::Transient) == TextureFlags::Transient) {
+        return GERIUM_MEMORY_CATEGORY_TRANSIENT_TARGET;
+    }
+    if ((flags & TextureFlags::RenderTarget) == TextureFlags::RenderTarget) {
+        return GERIUM_MEMORY_CATEGORY_RENDER_TARGET;
+    }
+    return GERIUM_MEMORY_CATEGORY_TEXTURE;
+}
+
+void Device::defragment() {
+    if (!_defragmentationContext) {
+        if (_absoluteFrame - _defragmentationFrame < kDefragInterval || _pendingReleases) {
+            return;
+        }
+        VmaDefragmentationInfo info{};
+        info.flags                 = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_FAST_BIT;
+        info.maxBytesPerPass       = kDefragBytesPerPass;
+        info.maxAllocationsPerPass = kDefragMovesPerPass;
+        check(vmaBeginDefragmentation(_vmaAllocator, &info, &_defragmentationContext));
+    } else if (_defragmentationPass.moveCount) {
+        // Old resources can be released only when the frames still reading them are done
+        if (completedTimelineValue() < _defragmentationTimelineValue) {
+            return;
+        }
+        if (endDefragmentationPass()) {
+            finishDefragmentation();
+            return;
+        }
+    }
+    beginDefragmentationPass();
+}
+
+void Device::beginDefragmentationPass() {
+    _defragmentationFrame         = _absoluteFrame;
+    _defragmentationTimelineValue = _frameTimelineValue;
+
+    if (vmaBeginDefragmentationPass(_vmaAllocator, _defragmentationContext, &_defragmentationPass) == VK_SUCCESS) {
+        finishDefragmentation();
+        return;
+    }
+
+    absl::flat_hash_map<VmaAllocation, std::pair<ResourceType, Handle>> owners;
+    for (auto texture : _textures) {
+        if (texture->vmaAllocation && texture->parentTexture == Undefined) {
+            owners[texture->vmaAllocation] = { ResourceType::Texture, _textures.handle(texture) };
+        }
+    }
+    for (auto texture : _textures) {
+        // Views share the image of their parent, such textures stay where they are
+        if (texture->parentTexture != Undefined) {
+            owners.erase(_textures.access(texture->parentTexture)->vmaAllocation);
+        }
+    }
+    for (auto buffer : _buffers) {
+        if (buffer->parent == Undefined && !buffer->heapBlock && buffer->vmaAllocation) {
+            owners[buffer->vmaAllocation] = { ResourceType::Buffer, _buffers.handle(buffer) };
+        }
+    }
+
+    CommandBuffer* commandBuffer = nullptr;
+    for (uint32_t i = 0; i < _defragmentationPass.moveCount; ++i) {
+        auto& move = _defragmentationPass.pMoves[i];
+
+        auto moved = false;
+        if (auto it = owners.find(move.srcAllocation); it != owners.end()) {
+            const auto [type, handle] = it->second;
+            moved = type == ResourceType::Texture ? moveTexture(handle, move, commandBuffer)
+                                                  : moveBuffer(handle, move, commandBuffer);
+            if (moved) {
+                _defragmentationMoves.back().move = i;
+            }
+        }
+        if (!moved) {
+            move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+        }
+    }
+
+    // The copies go to the graphics queue rather than the transfer queue. The transfer queue is submitted to by the
+    // upload thread and may be missing, and the moved resources are owned by the graphics family, so a transfer
+    // submit would need ownership barriers on both objects plus a semaphore wait in the next frame. Here the copies
+    // are ordered before the frame by queue order and the pass waits on the frame timeline value
+    if (commandBuffer) {
+        submit(commandBuffer);
+    } else if (endDefragmentationPass()) {
+        finishDefragmentation();
+    }
+}
+
+bool Device::endDefragmentationPass() {
+    for (const auto& move : _defragmentationMoves) {
+        if (move.type == ResourceType::Texture) {
+            _vkTable.vkDestroyImage(_device, _textures.access(move.previous)->vkImage, getAllocCalls());
+            _textures.release(move.previous);
+        } else {
+            _vkTable.vkDestroyBuffer(_device, _buffers.access(move.previous)->vkBuffer, getAllocCalls());
+            _buffers.release(move.previous);
+        }
+    }
+
+    // The allocation handles stay the same, after the pass they refer to the new memory
+    const auto result = vmaEndDefragmentationPass(_vmaAllocator, _defragmentationContext, &_defragmentationPass);
+
+    for (const auto& move : _defragmentationMoves) {
+        if (move.type == ResourceType::Buffer && !move.abandoned) {
+            auto buffer = _buffers.access(move.handle);
+            if (buffer->vmaAllocation == move.allocation) {
+                VmaAllocationInfo allocationInfo;
+                vmaGetAllocationInfo(_vmaAllocator, buffer->vmaAllocation, &allocationInfo);
+                buffer->vkDeviceMemory = allocationInfo.deviceMemory;
+            }
+        }
+    }
+
+    _defragmentationMoves.clear();
+    _defragmentationPass = {};
+    return result == VK_SUCCESS;
+}
+
+void Device::finishDefragmentation() {
+    if (!_defragmentationContext) {
+        return;
+    }
+    if (_defragmentationPass.moveCount) {
+        endDefragmentationPass();
+    }
+
+    VmaDefragmentationStats stats{};
+    vmaEndDefragmentation(_vmaAllocator, _defragmentationContext, &stats);
+    _defragmentationContext = VK_NULL_HANDLE;
+    _defragmentationFrame   = _absoluteFrame;
+
+    if (stats.bytesMoved) {
+        _logger->print(GERIUM_LOGGER_LEVEL_DEBUG, [&stats](auto& stream) {
+            stream << "Defragmentation moved "sv << stats.bytesMoved << " bytes, freed "sv << stats.bytesFreed
+                   << " bytes"sv;
+        });
+    }
+}
+
+bool Device::moveTexture(TextureHandle handle, const VmaDefragmentationMove& move, CommandBuffer*& commandBuffer) {
+    auto texture = _textures.access(handle);
+
+    // Render targets may share memory with aliased textures, partially loaded textures still get uploads
+    const auto renderTarget = (texture->flags & TextureFlags::RenderTarget) == TextureFlags::RenderTarget;
+    if (renderTarget || texture->loadedMips != texture->mipLevels || _swapchainImages.contains(handle)) {
+        return false;
+    }
+
+    const auto imageInfo = getImageCreateInfo(*texture);
+
+    VkImage vkImage;
+    if (_vkTable.vkCreateImage(_device, &imageInfo, getAllocCalls(), &vkImage) != VK_SUCCESS) {
+        return false;
+    }
+    if (vmaBindImageMemory(_vmaAllocator, move.dstTmpAllocation, vkImage) != VK_SUCCESS) {
+        _vkTable.vkDestroyImage(_device, vkImage, getAllocCalls());
+        return false;
+    }
+    setObjectName(VK_OBJECT_TYPE_IMAGE, (uint64_t) vkImage, texture->name);
+
+    // The new image is copied into through a temporary pool entry, which then keeps the old image until the pass ends
+    auto [previous, previousTexture] = _textures.obtain_and_access();
+    texture                          = _textures.access(handle);
+    *previousTexture                 = *texture;
+    previousTexture->vkImage         = vkImage;
+    previousTexture->vkImageView     = VK_NULL_HANDLE;
+    previousTexture->sampler         = Undefined;
+    std::fill(std::begin(previousTexture->states), std::end(previousTexture->states), ResourceState::Undefined);
+
+    if (!commandBuffer) {
+        commandBuffer = getPrimaryCommandBuffer(false);
+    }
+    commandBuffer->copyTexture(handle, 0, previous, 0, texture->mipLevels);
+
+    std::swap(texture->vkImage, previousTexture->vkImage);
+    std::swap(texture->states, previousTexture->states);
+    showViewMips(handle, 0);
+    invalidateDescriptorSets(handle);
+
+    _defragmentationMoves.push_back({ ResourceType::Texture, handle, previous, move.srcAllocation, 0, false });
+    return true;
+}
+
+bool Device::moveBuffer(BufferHandle handle, const VmaDefragmentationMove& move, CommandBuffer*& commandBuffer) {
+    auto buffer = _buffers.access(handle);
+
+    // Only buffers that are never written from the CPU after creation are moved
+    if (buffer->usage != ResourceUsageType::Immutable || buffer->mappedData) {
+        return false;
+    }
+
+    VkBufferCreateInfo bufferCreateInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    bufferCreateInfo.size  = buffer->size;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | buffer->vkUsageFlags;
+
+    VkBuffer vkBuffer;
+    if (_vkTable.vkCreateBuffer(_device, &bufferCreateInfo, getAllocCalls(), &vkBuffer) != VK_SUCCESS) {
+        return false;
+    }
+    if (vmaBindBufferMemory(_vmaAllocator, move.dstTmpAllocation, vkBuffer) != VK_SUCCESS) {
+        _vkTable.vkDestroyBuffer(_device, vkBuffer, getAllocCalls());
+        return false;
+    }
+    setObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t) vkBuffer, buffer->name);
+
+    auto [previous, previousBuffer] = _buffers.obtain_and_access();
+    buffer                          = _buffers.access(handle);
+    *previousBuffer                 = *buffer;
+    previousBuffer->vkBuffer        = vkBuffer;
+    previousBuffer->state           = ResourceState::Undefined;
+
+    if (!commandBuffer) {
+        commandBuffer = getPrimaryCommandBuffer(false);
+    }
+    commandBuffer->copyBuffer(handle, previous);
+    commandBuffer->addBufferBarrier(previous, ResourceState::GenericRead);
+
+    std::swap(buffer->vkBuffer, previousBuffer->vkBuffer);
+    std::swap(buffer->state, previousBuffer->state);
+    invalidateDescriptorSets(handle);
+
+    _defragmentationMoves.push_back({ ResourceType::Buffer, handle, previous, move.srcAllocation, 0, false });
+    return true;
+}
+
+bool Device::abandonDefragmentationMove(VmaAllocation allocation) noexcept {
+    for (auto& move : _defragmentationMoves) {
+        if (move.allocation == allocation && !move.abandoned) {
+            // VMA frees both places of the allocation when the pass ends
+            _defragmentationPass.pMoves[move.move].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_DESTROY;
+            move.abandoned                                   = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Device::isDeviceLocal(VmaAllocation allocation) const noexcept {
+    VkMemoryPropertyFlags memPropFlags;
+    vmaGetAllocationMemoryProperties(_vmaAllocator, allocation, &memPropFlags);
+    // Host visible device memory (UMA, resizable BAR) is not worth moving anywhere
+    return (memPropFlags & (VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) ==
+           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+}
+
 TextureHandle Device::getDefaultTexture(const DescriptorSetLayout& descriptorSetLayout,
                                         uint32_t binding) const noexcept {
     return descriptorSetLayout.data.default3DTextures.contains(binding) ? _defaultTexture3D : _defaultTexture;
@@ -3032,7 +4091,9 @@ std::vector<const char*> Device::selectDeviceExtensions(VkPhysicalDevice device,
     std::vector<std::pair<const char*, bool>> extensions = {
         { VK_KHR_SWAPCHAIN_EXTENSION_NAME,                 true  },
         { VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,             false },
-        { VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME, false }  // need FidelityFX
+        { VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME, false }, // need FidelityFX
+        { VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,         false },
+        { VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME,     false }
     };
 
     if (meshShader) {
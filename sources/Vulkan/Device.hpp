@@ -19,7 +19,8 @@ public:
     void create(Application* application,
                 gerium_feature_flags_t features,
                 gerium_uint32_t version,
-                bool enableValidations);
+                bool enableValidations,
+                gerium_uint32_t framesInFlight = kDefaultFramesInFlight);
 
     bool newFrame();
     void submit(CommandBuffer* commandBuffer);
@@ -51,6 +52,8 @@ public:
 
     void finishLoadTexture(TextureHandle handle, uint8_t mip, bool immediately = false);
     void showViewMips(TextureHandle handle, uint8_t mip);
+    void swapTextures(TextureHandle lhs, TextureHandle rhs);
+    bool demoteBuffer(BufferHandle handle);
 
     void bind(DescriptorSetHandle handle,
               gerium_uint16_t binding,
@@ -59,9 +62,9 @@ public:
               bool dynamic                = false,
               gerium_utf8_t resourceInput = nullptr,
               bool fromPreviousFrame      = false);
-    VkDescriptorSet updateDescriptorSet(DescriptorSetHandle handle,
-                                        DescriptorSetLayoutHandle layoutHandle,
-                                        FrameGraph* frameGraph);
+    std::pair<VkDescriptorSet, bool> updateDescriptorSet(DescriptorSetHandle handle,
+                                                         DescriptorSetLayoutHandle layoutHandle,
+                                                         FrameGraph* frameGraph);
 
     CommandBuffer* getPrimaryCommandBuffer(bool profile = true);
     CommandBuffer* getSecondaryCommandBuffer(gerium_uint32_t thread,
@@ -82,7 +85,13 @@ public:
 
     bool isSupportedFormat(gerium_format_t format) noexcept;
 
+    bool calibrateTimestamps(gerium_uint64_t& gpuTimestamp, gerium_uint64_t& cpuTimestamp);
+
     uint32_t totalMemoryUsed();
+    void getMemoryStats(std::vector<gerium_memory_stats_t>& memoryStats) const;
+    void getMemoryBudget(gerium_uint64_t& budget, gerium_uint64_t& usage);
+    gerium_uint64_t getTextureMemory(TextureHandle handle) const noexcept;
+    void getEvictionCandidates(gerium_uint32_t minIdleFrames, std::vector<gerium_eviction_t>& candidates);
 
     const vk::detail::DispatchLoaderDynamic& vkTable() const noexcept {
         return _vkTable;
@@ -104,10 +113,18 @@ public:
         return _absoluteFrame;
     }
 
+    gerium_uint32_t framesInFlight() const noexcept {
+        return _framesInFlight;
+    }
+
     VkQueryPool vkQueryPool() noexcept {
         return _queryPool;
     }
 
+    VkQueryPool vkStatisticsQueryPool() noexcept {
+        return _statisticsQueryPool;
+    }
+
     double gpuFrequency() const noexcept {
         return _gpuFrequency;
     }
@@ -156,6 +173,18 @@ public:
         return _16BitStorageSupported;
     }
 
+    bool dynamicRenderingSupported() const noexcept {
+        return _dynamicRenderingSupported;
+    }
+
+    VkQueryPipelineStatisticFlags pipelineStatistics() const noexcept {
+        return _pipelineStatistics;
+    }
+
+    bool inheritedQueriesSupported() const noexcept {
+        return _inheritedQueriesSupported;
+    }
+
     TextureCompressionFlags compressions() const noexcept {
         return _compressions;
     }
@@ -167,6 +196,7 @@ public:
     void setProfilerEnable(bool enable) noexcept {
         if (_profilerSupported) {
             _profilerEnabled = enable;
+            _profiler->setEnabled(enable);
         }
     }
 
@@ -193,6 +223,7 @@ public:
 
     FfxResource ffxBuffer(BufferHandle handle) const noexcept {
         auto buffer = _buffers.access(handle);
+        assert(buffer->parent == Undefined && "FidelityFX cannot address a range of a shared buffer");
 
         FfxResourceDescription resourceDescription{};
         resourceDescription.type  = FFX_RESOURCE_TYPE_BUFFER;
@@ -297,6 +328,13 @@ private:
         Pipeline
     };
 
+    static constexpr auto kResourceTypeCount = size_t(ResourceType::Pipeline) + 1;
+
+    static constexpr auto kMemoryCategoryCount = size_t(GERIUM_MEMORY_CATEGORY_RECYCLED) + 1;
+
+    static constexpr gerium_uint64_t kLargeUploadSize   = 1024 * 1024;
+    static constexpr gerium_uint32_t kDeletionBurstSize = 32;
+
     struct QueueFamily {
         uint8_t index;
         uint8_t queue;
@@ -328,9 +366,54 @@ private:
     };
 
     struct ResourceDeletion {
+        gerium_uint64_t timelineValue;
+        Handle handle;
+    };
+
+    // Descriptor sets are returned to the pool on the render thread, the other objects of a batch can be
+    // destroyed from any thread
+    struct ReleaseBatch {
+        std::vector<VkBuffer> buffers;
+        std::vector<VkImage> images;
+        std::vector<VkImageView> imageViews;
+        std::vector<VkSampler> samplers;
+        std::vector<VkRenderPass> renderPasses;
+        std::vector<VkFramebuffer> framebuffers;
+        std::vector<VkShaderModule> shaderModules;
+        std::vector<VkDescriptorSet> descriptorSets;
+        std::vector<VkDescriptorSetLayout> descriptorSetLayouts;
+        std::vector<VkPipelineLayout> pipelineLayouts;
+        std::vector<VkPipeline> pipelines;
+        std::vector<VmaAllocation> allocations;
+
+        size_t size() const noexcept {
+            return buffers.size() + images.size() + imageViews.size() + samplers.size() + renderPasses.size() +
+                   framebuffers.size() + shaderModules.size() + descriptorSetLayouts.size() +
+                   pipelineLayouts.size() + pipelines.size() + allocations.size();
+        }
+    };
+
+    struct DefragmentationMove {
         ResourceType type;
-        uint32_t frame;
         Handle handle;
+        Handle previous;
+        VmaAllocation allocation;
+        uint32_t move;
+        bool abandoned;
+    };
+
+    struct RecycledTexture {
+        VkImage image;
+        VmaAllocation allocation;
+        gerium_uint32_t frame;
+    };
+
+    struct RecycledBuffer {
+        VkBuffer buffer;
+        VmaAllocation allocation;
+        VkDeviceMemory deviceMemory;
+        void* mappedData;
+        gerium_uint32_t frame;
     };
 
     void createInstance(gerium_utf8_t appName, gerium_uint32_t version);
@@ -368,13 +451,51 @@ private:
     VkRenderPass vkCreateRenderPass(const RenderPassOutput& output, const char* name);
     void vkCreateImageView(const TextureViewCreation& creation, TextureHandle handle);
     void deleteResources(bool forceDelete = false);
+    void deleteResource(ResourceType type, Handle handle);
+    void flushReleaseBatch(bool forceDelete);
+    void release(ReleaseBatch& batch) noexcept;
     void setObjectName(VkObjectType type, uint64_t handle, gerium_utf8_t name);
     int getPhysicalDeviceScore(VkPhysicalDevice device);
     QueueFamilies getQueueFamilies(VkPhysicalDevice device);
     Swapchain getSwapchain();
     void frameCountersAdvance() noexcept;
+    gerium_uint64_t completedTimelineValue() const;
     void uploadTextureData(TextureHandle handle, gerium_cdata_t data);
     TextureHandle getDefaultTexture(const DescriptorSetLayout& descriptorSetLayout, uint32_t binding) const noexcept;
+    void markUsed(BufferHandle handle) noexcept;
+    void countDynamicBytes(gerium_uint32_t size) noexcept;
+    void markUsed(VkDescriptorType type, Handle resource) noexcept;
+    void markUsed(const DescriptorSetLayout& descriptorSetLayout, const DescriptorSet& descriptorSet) noexcept;
+    void invalidateDescriptorSets(Handle resource) noexcept;
+    bool isDeviceLocal(VmaAllocation allocation) const noexcept;
+    VkImageCreateInfo getImageCreateInfo(const Texture& texture) const noexcept;
+    void allocateFromHeap(BufferHandle handle);
+    BufferHandle createHeapBlock();
+    void freeFromHeap(const Buffer& buffer) noexcept;
+    bool recycleTexture(const Texture& texture);
+    bool recycleBuffer(const Buffer& buffer);
+    bool reuseTexture(const VkImageCreateInfo& imageInfo, Texture& texture);
+    bool reuseBuffer(gerium_uint64_t key, Buffer& buffer);
+    bool releaseRecycled(bool all = false);
+    static gerium_uint64_t calcRecycleKey(const VkImageCreateInfo& imageInfo) noexcept;
+    static gerium_uint64_t calcRecycleKey(VkBufferUsageFlags usageFlags,
+                                          ResourceUsageType usage,
+                                          gerium_uint32_t size,
+                                          bool persistent) noexcept;
+    void trackMemory(gerium_memory_category_t category, gerium_uint64_t size, bool allocated) noexcept;
+    void trackAliasedMemory(gerium_memory_category_t category, gerium_uint64_t size, bool aliased) noexcept;
+    void setMemoryCategory(BufferHandle handle, gerium_memory_category_t category) noexcept;
+    gerium_uint64_t allocationSize(VmaAllocation allocation) const noexcept;
+    static gerium_memory_category_t calcMemoryCategory(const BufferCreation& creation) noexcept;
+    static gerium_memory_category_t calcMemoryCategory(TextureFlags flags) noexcept;
+
+    void defragment();
+    void beginDefragmentationPass();
+    bool endDefragmentationPass();
+    void finishDefragmentation();
+    bool moveTexture(TextureHandle handle, const VmaDefragmentationMove& move, CommandBuffer*& commandBuffer);
+    bool moveBuffer(BufferHandle handle, const VmaDefragmentationMove& move, CommandBuffer*& commandBuffer);
+    bool abandonDefragmentationMove(VmaAllocation allocation) noexcept;
 
     std::vector<const char*> selectValidationLayers();
     std::vector<const char*> selectExtensions();
@@ -431,6 +552,7 @@ private:
     VkQueue _queuePresent{};
     VkQueue _queueTransfer{};
     VkQueryPool _queryPool{};
+    VkQueryPool _statisticsQueryPool{};
     marl::mutex _descriptorPoolMutex{};
     VkDescriptorPool _globalDescriptorPool{};
     VkDescriptorPool _descriptorPools[kMaxFrames]{};
@@ -438,7 +560,9 @@ private:
     VmaAllocator _vmaAllocator{};
     VkSemaphore _imageAvailableSemaphores[kMaxFrames]{};
     VkSemaphore _renderFinishedSemaphores[kMaxFrames]{};
-    VkFence _inFlightFences[kMaxFrames]{};
+    VkSemaphore _frameTimeline{};
+    gerium_uint64_t _frameTimelineValue{ 1 };
+    gerium_uint64_t _frameTimelineValues[kMaxFrames]{};
     VkSwapchainKHR _swapchain{};
     VkSurfaceFormatKHR _swapchainFormat{};
     VkExtent2D _swapchainExtent{};
@@ -446,8 +570,9 @@ private:
     std::vector<FramebufferHandle> _swapchainFramebuffers{};
     std::set<TextureHandle> _swapchainImages{};
     gerium_uint32_t _swapchainImageIndex{};
+    gerium_uint32_t _framesInFlight{ kDefaultFramesInFlight };
     gerium_uint32_t _currentFrame{};
-    gerium_uint32_t _previousFrame{ kMaxFrames - 1 };
+    gerium_uint32_t _previousFrame{ kDefaultFramesInFlight - 1 };
     gerium_uint32_t _absoluteFrame{};
     uint32_t _dynamicUBOSize{};
     uint32_t _dynamicSSBOSize{};
@@ -475,16 +600,29 @@ private:
     FramebufferPool _framebuffers;
 
     CommandBufferPool _commandBufferPool{};
-    std::queue<ResourceDeletion> _deletionQueue{};
+    std::queue<ResourceDeletion> _deletionQueues[kResourceTypeCount]{};
+    ReleaseBatch _releaseBatch{};
+    marl::WaitGroup _releaseGroup{};
+    std::atomic<gerium_uint32_t> _pendingReleases{};
     std::map<gerium_uint64_t, RenderPassHandle> _renderPassCache{};
     CommandBuffer* _queuedCommandBuffers[16]{};
     CommandBuffer* _frameCommandBuffer{};
     gerium_uint32_t _numQueuedCommandBuffers{};
     std::map<gerium_uint64_t, SamplerHandle> _samplerCache{};
     std::vector<std::pair<VkDescriptorSet, gerium_uint64_t>> _freeDescriptorSetQueue{};
+    std::vector<VkDescriptorSet> _freeDescriptorSets{};
+    std::vector<BufferHandle> _bufferHeap{};
+    std::multimap<gerium_uint64_t, RecycledTexture> _recycledTextures{};
+    std::multimap<gerium_uint64_t, RecycledBuffer> _recycledBuffers{};
+    gerium_memory_stats_t _memoryStats[kMemoryCategoryCount]{};
     std::vector<std::pair<gerium_uint32_t, VkImageView>> _unusedImageViews{};
+    VmaDefragmentationContext _defragmentationContext{};
+    VmaDefragmentationPassMoveInfo _defragmentationPass{};
+    std::vector<DefragmentationMove> _defragmentationMoves{};
+    gerium_uint32_t _defragmentationFrame{};
+    gerium_uint64_t _defragmentationTimelineValue{};
     std::vector<std::pair<TextureHandle, uint8_t>> _finishedLoadTextures{};
-    std::map<gerium_uint64_t, Handle> _currentInputResources{};
+    absl::flat_hash_map<gerium_uint64_t, Handle> _currentInputResources{};
 
     VkPhysicalDeviceProperties _deviceProperties{};
     VkPhysicalDeviceMemoryProperties _deviceMemProperties{};
@@ -498,6 +636,10 @@ private:
     bool _samplerFilterMinmaxSupported{};
     bool _8BitStorageSupported{};
     bool _16BitStorageSupported{};
+    bool _dynamicRenderingSupported{};
+    bool _calibratedTimestampsSupported{};
+    bool _inheritedQueriesSupported{};
+    VkQueryPipelineStatisticFlags _pipelineStatistics{};
     TextureCompressionFlags _compressions{};
     double _gpuFrequency{};
     ObjectPtr<VkProfiler> _profiler{};
@@ -14,7 +14,8 @@ namespace gerium::vulkan {
 
 // clang-format off
 
-constexpr uint32_t kMaxFrames               = 2;
+constexpr uint32_t kMaxFrames               = 4;
+constexpr uint32_t kDefaultFramesInFlight   = 2;
 constexpr uint8_t  kMaxImageOutputs         = 8;
 constexpr uint8_t  kMaxDescriptorSetLayouts = 4;
 constexpr uint8_t  kMaxDescriptorsPerSet    = 16;
@@ -25,6 +26,14 @@ constexpr uint8_t  kMaxTechniquePasses      = 20;
 constexpr uint32_t kGlobalPoolElements      = 4096;
 constexpr uint32_t kBindlessPoolElements    = 1024;
 constexpr uint32_t kDescriptorSetsPoolSize  = 4096;
+constexpr uint32_t kDefragInterval          = 600;
+constexpr uint64_t kDefragBytesPerPass      = 16 * 1024 * 1024;
+constexpr uint32_t kDefragMovesPerPass      = 64;
+constexpr uint32_t kBufferHeapBlockSize     = 32 * 1024 * 1024;
+constexpr uint32_t kBufferHeapMaxSize       = 256 * 1024;
+constexpr uint32_t kRecycleFrames           = 8;
+constexpr float    kRecycleBudgetRatio      = 0.85f;
+constexpr uint32_t kAsyncReleaseThreshold   = 256;
 
 struct SamplerHandle : Handle {};
 struct DescriptorSetLayoutHandle : Handle {};
@@ -342,40 +351,48 @@ struct DescriptorSetCreation {
 };*/
 
 struct Buffer {
-    VkBuffer           vkBuffer;
-    VmaAllocation      vmaAllocation;
-    VkDeviceMemory     vkDeviceMemory;
-    VkBufferUsageFlags vkUsageFlags;
-    ResourceUsageType  usage;
-    ResourceState      state;
-    gerium_uint32_t    size;
-    gerium_uint32_t    globalOffset;
-    void*              mappedData;
-    gerium_uint32_t    mappedOffset;
-    gerium_uint32_t    mappedSize;
-    gerium_utf8_t      name;
-    BufferHandle       parent;
+    VkBuffer                 vkBuffer;
+    VmaAllocation            vmaAllocation;
+    VkDeviceMemory           vkDeviceMemory;
+    VkBufferUsageFlags       vkUsageFlags;
+    ResourceUsageType        usage;
+    ResourceState            state;
+    gerium_uint32_t          size;
+    gerium_uint32_t          globalOffset;
+    void*                    mappedData;
+    gerium_uint32_t          mappedOffset;
+    gerium_uint32_t          mappedSize;
+    gerium_utf8_t            name;
+    BufferHandle             parent;
+    gerium_uint32_t          lastUsedFrame;
+    VmaVirtualBlock          heapBlock;
+    VmaVirtualAllocation     heapAllocation;
+    gerium_memory_category_t memoryCategory;
+    gerium_uint64_t          memorySize;
 };
 
 struct Texture {
-    VkImage               vkImage;
-    VkImageView           vkImageView;
-    VkFormat              vkFormat;
-    VmaAllocation         vmaAllocation;
-    gerium_uint32_t       size;
-    uint16_t              width;
-    uint16_t              height;
-    uint16_t              depth;
-    uint8_t               mipBase;
-    uint8_t               mipLevels;
-    uint8_t               layers;
-    uint8_t               loadedMips;
-    TextureFlags          flags;
-    gerium_texture_type_t type;
-    gerium_utf8_t         name;
-    TextureHandle         parentTexture;
-    SamplerHandle         sampler;
-    ResourceState         states[16];
+    VkImage                  vkImage;
+    VkImageView              vkImageView;
+    VkFormat                 vkFormat;
+    VmaAllocation            vmaAllocation;
+    gerium_uint32_t          size;
+    uint16_t                 width;
+    uint16_t                 height;
+    uint16_t                 depth;
+    uint8_t                  mipBase;
+    uint8_t                  mipLevels;
+    uint8_t                  layers;
+    uint8_t                  loadedMips;
+    TextureFlags             flags;
+    gerium_texture_type_t    type;
+    gerium_utf8_t            name;
+    TextureHandle            parentTexture;
+    SamplerHandle            sampler;
+    ResourceState            states[16];
+    gerium_uint32_t          lastUsedFrame;
+    gerium_memory_category_t memoryCategory;
+    gerium_uint64_t          memorySize;
 };
 
 struct Sampler {
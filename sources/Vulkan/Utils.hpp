@@ -241,6 +241,13 @@ gerium_inline VkIndexType toVkIndexType(gerium_index_type_t type) noexcept {
     return (VkIndexType) type;
 }
 
+gerium_inline VkAttachmentLoadOp toVkAttachmentLoadOp(RenderPassOp operation) noexcept {
+    constexpr VkAttachmentLoadOp operations[] = { VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                                                  VK_ATTACHMENT_LOAD_OP_LOAD,
+                                                  VK_ATTACHMENT_LOAD_OP_CLEAR };
+    return operations[int(operation)];
+}
+
 gerium_inline VkAccessFlags toVkAccessFlags(ResourceState state) noexcept {
     VkAccessFlags ret = 0;
     if ((state & ResourceState::CopySource) == ResourceState::CopySource) {
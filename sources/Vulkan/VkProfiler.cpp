@@ -4,17 +4,47 @@
 
 namespace gerium::vulkan {
 
+using Statistics = gerium_pipeline_statistics_t;
+
+// Values of a pipeline statistics query are written in the order of their bits
+static const std::pair<VkQueryPipelineStatisticFlagBits, gerium_uint64_t Statistics::*> kStatisticsFields[] = {
+    { VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT,     &Statistics::input_assembly_vertices     },
+    { VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT,   &Statistics::input_assembly_primitives   },
+    { VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT,   &Statistics::vertex_shader_invocations   },
+    { VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT,        &Statistics::clipping_invocations        },
+    { VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT,         &Statistics::clipping_primitives         },
+    { VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT, &Statistics::fragment_shader_invocations },
+    { VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT,  &Statistics::compute_shader_invocations  },
+    { VK_QUERY_PIPELINE_STATISTIC_TASK_SHADER_INVOCATIONS_BIT_EXT, &Statistics::task_shader_invocations     },
+    { VK_QUERY_PIPELINE_STATISTIC_MESH_SHADER_INVOCATIONS_BIT_EXT, &Statistics::mesh_shader_invocations     }
+};
+
 VkProfiler::VkProfiler(Device& device, uint16_t queriesPerFrame, uint16_t maxFrames) :
     _device(&device),
     _queriesPerFrame(queriesPerFrame),
+    _maxFrames(maxFrames),
     _currentQuery(0),
-    _previosQuery(0),
-    _previosFrame(0),
     _parentQuery(0),
     _depth(0),
+    _currentStatistics(0),
+    _statisticsValues(0),
+    _pipelineStatisticsEnabled(false),
     _totalMemoryUsed(0) {
     _timestamps.resize(_queriesPerFrame * maxFrames);
-    _timestampsData.resize(_queriesPerFrame * maxFrames * 2);
+    // Every query is read together with its availability value
+    _timestampsData.resize(_queriesPerFrame * maxFrames * 2 * 2);
+    _frames.resize(maxFrames);
+    _results.reserve(_queriesPerFrame);
+
+    for (const auto& [bit, field] : kStatisticsFields) {
+        if (_device->pipelineStatistics() & bit) {
+            ++_statisticsValues;
+        }
+    }
+    _statisticsNames.resize(_queriesPerFrame * maxFrames);
+    // Every query is read together with its availability value
+    _statisticsData.resize(_queriesPerFrame * maxFrames * (_statisticsValues + 1));
+    _statisticsResults.reserve(_queriesPerFrame);
 }
 
 uint32_t VkProfiler::pushTimestamp(gerium_utf8_t name) {
@@ -45,59 +75,182 @@ uint32_t VkProfiler::popTimestamp() {
 }
 
 void VkProfiler::resetTimestamps() {
-    _currentQuery = 0;
-    _parentQuery  = 0;
-    _depth        = 0;
+    // The frame that used this slot is complete at this point, its results have to be taken before the queries
+    // are reset
+    if (auto& queries = _frames[_device->currentFrame()]; queries.pending) {
+        readFrame(_device->currentFrame());
+        queries.pending = false;
+    }
+
+    _currentQuery      = 0;
+    _parentQuery       = 0;
+    _depth             = 0;
+    _currentStatistics = 0;
 }
 
 bool VkProfiler::hasTimestamps() const noexcept {
     return _currentQuery > 0 && _depth == 0;
 }
 
+uint32_t VkProfiler::beginStatistics(gerium_utf8_t name) {
+    if (!_pipelineStatisticsEnabled || _currentStatistics == _queriesPerFrame) {
+        return kNoQuery;
+    }
+    const uint32_t queryIndex = (_device->currentFrame() * _queriesPerFrame) + _currentStatistics++;
+
+    _statisticsNames[queryIndex] = intern(name);
+    return queryIndex;
+}
+
 uint16_t VkProfiler::queriesPerFrame() const noexcept {
     return _queriesPerFrame;
 }
 
 void VkProfiler::fetchDataFromGpu() {
     if (hasTimestamps()) {
-        const auto queryOffset = _device->currentFrame() * _queriesPerFrame * 2;
-        const auto queryCount  = _currentQuery * 2;
-
-        check(_device->vkTable().vkGetQueryPoolResults(_device->vkDevice(),
-                                                       _device->vkQueryPool(),
-                                                       queryOffset,
-                                                       queryCount,
-                                                       sizeof(uint64_t) * queryCount,
-                                                       &_timestampsData[queryOffset],
-                                                       sizeof(uint64_t),
-                                                       VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
-
-        for (uint32_t q = 0; q < _currentQuery; ++q) {
-            auto index = _device->currentFrame() * _queriesPerFrame + q;
-
-            auto& timestamp = _timestamps[index];
-
-            double start   = (double) _timestampsData[index * 2];
-            double end     = (double) _timestampsData[index * 2 + 1];
-            double range   = end - start;
-            double elapsed = range * _device->gpuFrequency();
-
-            timestamp.frame   = _device->absoluteFrame();
-            timestamp.elapsed = elapsed;
+        auto& queries   = _frames[_device->currentFrame()];
+        queries.count           = _currentQuery;
+        queries.statisticsCount = _currentStatistics;
+        queries.frame           = _device->absoluteFrame();
+        queries.pending         = true;
+        queries.traced          = isCapturingTrace();
+
+        if (queries.traced && !_device->calibrateTimestamps(queries.gpuCalibration, queries.cpuCalibration)) {
+            // Without calibrated timestamps the frame is assumed to start on the GPU when it has been submitted
+            queries.gpuCalibration = 0;
+            queries.cpuCalibration = cpuTimestamp();
         }
     }
 
-    _previosQuery = _currentQuery;
-    _previosFrame = _device->currentFrame();
+    // Results are polled from the oldest frame in flight to the newest, a frame that is not finished yet is
+    // left for a later call instead of stalling the CPU until the GPU is done
+    for (uint32_t i = 1; i <= _maxFrames; ++i) {
+        const auto frame = (_device->currentFrame() + i) % _maxFrames;
+        if (!_frames[frame].pending) {
+            continue;
+        }
+        if (!readFrame(frame)) {
+            break;
+        }
+        _frames[frame].pending = false;
+    }
 
     _totalMemoryUsed = _device->totalMemoryUsed();
+    _device->getMemoryStats(_memoryStats);
+}
+
+bool VkProfiler::readFrame(uint32_t frame) {
+    const auto& queries    = _frames[frame];
+    const auto queryOffset = frame * _queriesPerFrame * 2;
+    const auto queryCount  = queries.count * 2;
+    const auto data        = &_timestampsData[queryOffset * 2];
+
+    const auto result = _device->vkTable().vkGetQueryPoolResults(_device->vkDevice(),
+                                                                 _device->vkQueryPool(),
+                                                                 queryOffset,
+                                                                 queryCount,
+                                                                 sizeof(uint64_t) * 2 * queryCount,
+                                                                 data,
+                                                                 sizeof(uint64_t) * 2,
+                                                                 VK_QUERY_RESULT_64_BIT |
+                                                                     VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (result != VK_NOT_READY) {
+        check(result);
+    }
+
+    for (uint32_t q = 0; q < queryCount; ++q) {
+        if (!data[q * 2 + 1]) {
+            return false;
+        }
+    }
+
+    if (!readStatistics(frame)) {
+        return false;
+    }
+
+    const auto gpuBase   = queries.gpuCalibration ? queries.gpuCalibration : data[0];
+    const auto nsPerTick = _device->gpuFrequency() * 1000000.0;
+    const auto toCpu     = [&queries, gpuBase, nsPerTick](uint64_t ticks) {
+        const auto offset = (double) (gerium_sint64_t) (ticks - gpuBase) * nsPerTick;
+        return (uint64_t) ((gerium_sint64_t) queries.cpuCalibration + (gerium_sint64_t) offset);
+    };
+
+    _results.clear();
+    for (uint32_t q = 0; q < queries.count; ++q) {
+        auto timestamp = _timestamps[frame * _queriesPerFrame + q];
+
+        double start   = (double) data[q * 4];
+        double end     = (double) data[q * 4 + 2];
+        double range   = end - start;
+        double elapsed = range * _device->gpuFrequency();
+
+        timestamp.frame   = queries.frame;
+        timestamp.elapsed = elapsed;
+        _results.push_back(timestamp);
+
+        const auto parent = timestamp.depth ? _timestamps[frame * _queriesPerFrame + timestamp.parent].name : nullptr;
+        addSample(GERIUM_PROFILER_SCOPE_TYPE_GPU, timestamp.name, parent, timestamp.depth, elapsed);
+
+        if (queries.traced) {
+            addGpuTrace(timestamp.name, toCpu(data[q * 4]), toCpu(data[q * 4 + 2]));
+        }
+    }
+    return true;
+}
+
+bool VkProfiler::readStatistics(uint32_t frame) {
+    const auto& queries = _frames[frame];
+    if (!queries.statisticsCount) {
+        _statisticsResults.clear();
+        return true;
+    }
+
+    const auto queryOffset = frame * _queriesPerFrame;
+    const auto stride      = _statisticsValues + 1;
+    const auto data        = &_statisticsData[queryOffset * stride];
+
+    const auto result = _device->vkTable().vkGetQueryPoolResults(_device->vkDevice(),
+                                                                 _device->vkStatisticsQueryPool(),
+                                                                 queryOffset,
+                                                                 queries.statisticsCount,
+                                                                 sizeof(uint64_t) * stride * queries.statisticsCount,
+                                                                 data,
+                                                                 sizeof(uint64_t) * stride,
+                                                                 VK_QUERY_RESULT_64_BIT |
+                                                                     VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (result != VK_NOT_READY) {
+        check(result);
+    }
+
+    for (uint32_t q = 0; q < queries.statisticsCount; ++q) {
+        if (!data[q * stride + _statisticsValues]) {
+            return false;
+        }
+    }
+
+    _statisticsResults.clear();
+    for (uint32_t q = 0; q < queries.statisticsCount; ++q) {
+        auto value = &data[q * stride];
+
+        Statistics statistics{};
+        statistics.name  = _statisticsNames[queryOffset + q];
+        statistics.frame = queries.frame;
+        for (const auto& [bit, field] : kStatisticsFields) {
+            if (_device->pipelineStatistics() & bit) {
+                statistics.*field = *value++;
+            }
+        }
+        _statisticsResults.push_back(statistics);
+    }
+    return true;
 }
 
 void VkProfiler::onGetGpuTimestamps(gerium_uint32_t& gpuTimestampsCount,
                                     gerium_gpu_timestamp_t* gpuTimestamps) const noexcept {
-    gpuTimestampsCount = gpuTimestamps ? std::min(gpuTimestampsCount, _previosQuery) : _previosQuery;
+    const auto count   = (gerium_uint32_t) _results.size();
+    gpuTimestampsCount = gpuTimestamps ? std::min(gpuTimestampsCount, count) : count;
     if (gpuTimestamps) {
-        auto* timestamps = &_timestamps[_previosFrame * _queriesPerFrame];
+        const auto* timestamps = _results.data();
         for (gerium_uint32_t q = 0; q < gpuTimestampsCount; ++q) {
             gpuTimestamps[q].name    = timestamps[q].name;
             gpuTimestamps[q].elapsed = timestamps[q].elapsed;
@@ -107,6 +260,32 @@ void VkProfiler::onGetGpuTimestamps(gerium_uint32_t& gpuTimestampsCount,
     }
 }
 
+bool VkProfiler::onGetPipelineStatisticsEnable() const noexcept {
+    return _pipelineStatisticsEnabled;
+}
+
+void VkProfiler::onSetPipelineStatisticsEnable(bool enable) noexcept {
+    _pipelineStatisticsEnabled = enable && _device->pipelineStatistics();
+}
+
+void VkProfiler::onGetPipelineStatistics(gerium_uint32_t& pipelineStatisticsCount,
+                                         gerium_pipeline_statistics_t* pipelineStatistics) const noexcept {
+    const auto count        = (gerium_uint32_t) _statisticsResults.size();
+    pipelineStatisticsCount = pipelineStatistics ? std::min(pipelineStatisticsCount, count) : count;
+    if (pipelineStatistics) {
+        std::copy_n(_statisticsResults.cbegin(), pipelineStatisticsCount, pipelineStatistics);
+    }
+}
+
+void VkProfiler::onGetMemoryStats(gerium_uint32_t& memoryStatsCount,
+                                  gerium_memory_stats_t* memoryStats) const noexcept {
+    const auto count = (gerium_uint32_t) _memoryStats.size();
+    memoryStatsCount = memoryStats ? std::min(memoryStatsCount, count) : count;
+    if (memoryStats) {
+        std::copy_n(_memoryStats.cbegin(), memoryStatsCount, memoryStats);
+    }
+}
+
 gerium_uint32_t VkProfiler::onGetGpuTotalMemoryUsed() const noexcept {
     return _totalMemoryUsed;
 }
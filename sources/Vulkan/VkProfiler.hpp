@@ -19,6 +19,8 @@ public:
         gerium_utf8_t name;
     };
 
+    static constexpr uint32_t kNoQuery = std::numeric_limits<uint32_t>::max();
+
     VkProfiler(Device& device, uint16_t queriesPerFrame, uint16_t maxFrames);
 
     uint32_t pushTimestamp(gerium_utf8_t name);
@@ -26,27 +28,57 @@ public:
     void resetTimestamps();
     bool hasTimestamps() const noexcept;
 
+    uint32_t beginStatistics(gerium_utf8_t name);
+
     uint16_t queriesPerFrame() const noexcept;
 
     void fetchDataFromGpu();
 
 private:
+    struct FrameQueries {
+        uint32_t count;
+        uint32_t frame;
+        uint32_t statisticsCount;
+        bool pending;
+        bool traced;
+        uint64_t gpuCalibration;
+        uint64_t cpuCalibration;
+    };
+
+    bool readFrame(uint32_t frame);
+    bool readStatistics(uint32_t frame);
+
     void onGetGpuTimestamps(gerium_uint32_t& gpuTimestampsCount,
                             gerium_gpu_timestamp_t* gpuTimestamps) const noexcept override;
                             
     gerium_uint32_t onGetGpuTotalMemoryUsed() const noexcept override;
 
+    bool onGetPipelineStatisticsEnable() const noexcept override;
+    void onSetPipelineStatisticsEnable(bool enable) noexcept override;
+    void onGetPipelineStatistics(gerium_uint32_t& pipelineStatisticsCount,
+                                 gerium_pipeline_statistics_t* pipelineStatistics) const noexcept override;
+    void onGetMemoryStats(gerium_uint32_t& memoryStatsCount,
+                          gerium_memory_stats_t* memoryStats) const noexcept override;
+
     Device* _device;
 
     uint16_t _queriesPerFrame;
+    uint16_t _maxFrames;
     uint32_t _currentQuery;
-    uint32_t _previosQuery;
-    uint32_t _previosFrame;
     uint32_t _parentQuery;
     uint32_t _depth;
+    uint32_t _currentStatistics;
+    uint32_t _statisticsValues;
+    bool _pipelineStatisticsEnabled;
 
     std::vector<Timestamp> _timestamps;
     std::vector<uint64_t> _timestampsData;
+    std::vector<FrameQueries> _frames;
+    std::vector<Timestamp> _results;
+    std::vector<gerium_utf8_t> _statisticsNames;
+    std::vector<uint64_t> _statisticsData;
+    std::vector<gerium_pipeline_statistics_t> _statisticsResults;
+    std::vector<gerium_memory_stats_t> _memoryStats;
 
     uint32_t _totalMemoryUsed;
 };
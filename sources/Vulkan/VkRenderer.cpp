@@ -10,9 +10,19 @@ VkRenderer::VkRenderer(Application* application, ObjectPtr<Device>&& device) noe
     _width(0),
     _height(0),
     _currentRenderPassName(nullptr),
-    _transferMaxTasks(10),
+    _transferMaxTasks(64),
     _transferBuffer(Undefined),
     _transferBufferOffset(0),
+    _transferBufferUsed(0),
+    _transferBatch(nullptr),
+    _transferTimeline(VK_NULL_HANDLE),
+    _transferTimelineValue(0),
+    _transferBatchFirst(0),
+    _transferBatchCount(0),
+    _pendingUploads(0),
+    _pendingUploadBytes(0),
+    _frameUploads(0),
+    _frameUploadBytes(0),
     _loadEvent(marl::Event::Mode::Manual),
     _loadThreadEnd(marl::Event::Mode::Manual),
     _prevFrame(1),
@@ -28,6 +38,7 @@ VkRenderer::~VkRenderer() {
     _loadThreadEnd.signal();
     if (_isSupportedTransferQueue) {
         _loadTread.join();
+        destroyTransferBatches();
     }
 }
 
@@ -45,7 +56,7 @@ PipelineHandle VkRenderer::getPipeline(TechniqueHandle handle) const noexcept {
 }
 
 void VkRenderer::onInitialize(gerium_feature_flags_t features, gerium_uint32_t version, bool debug) {
-    _device->create(application(), features, version, debug);
+    _device->create(application(), features, version, debug, options().frames_in_flight);
     _isSupportedTransferQueue = _device->isSupportedTransferQueue();
     createTransferBuffer();
 }
@@ -56,13 +67,26 @@ Application* VkRenderer::application() noexcept {
 
 void VkRenderer::createTransferBuffer() {
     BufferCreation bc;
-    bc.reset().set({}, ResourceUsageType::Staging, 256 * 1024 * 1024).setName("staging_buffer").setPersistent(true);
+    bc.reset().set({}, ResourceUsageType::Staging, kTransferBufferSize).setName("staging_buffer").setPersistent(true);
     _transferBuffer       = _device->createBuffer(bc);
     _transferBufferOffset = 0;
 
-    _transferCommandPool.create(*_device.get(), 1, _transferMaxTasks, QueueType::CopyTransfer);
+    _transferCommandPool.create(*_device.get(), 1, kMaxTransferBatches, QueueType::CopyTransfer);
 
     if (_isSupportedTransferQueue) {
+        VkSemaphoreTypeCreateInfo typeInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue  = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+        semaphoreInfo.pNext = &typeInfo;
+        check(_device->vkTable().vkCreateSemaphore(
+            _device->vkDevice(), &semaphoreInfo, getAllocCalls(), &_transferTimeline));
+
+        for (auto& batch : _transferBatches) {
+            batch.requests.reserve(_transferMaxTasks);
+        }
+
         auto scheduler = marl::Scheduler::get();
 
         _loadTread = std::thread([this, scheduler]() {
@@ -73,49 +97,202 @@ void VkRenderer::createTransferBuffer() {
     }
 }
 
-void VkRenderer::sendTextureToGraphic() {
-    if (!_isSupportedTransferQueue) {
-        if (!_loadRequests.empty()) {
-            auto request = _loadRequests.front();
-            _loadRequests.pop();
+void VkRenderer::destroyTransferBatches() noexcept {
+    if (_transferTimeline) {
+        _device->vkTable().vkDestroySemaphore(_device->vkDevice(), _transferTimeline, getAllocCalls());
+        _transferTimeline = VK_NULL_HANDLE;
+    }
+}
+
+bool VkRenderer::allocateTransferData(size_t size, size_t& offset) {
+    // The staging buffer is a ring: data of submitted batches stays untouched until the transfer timeline
+    // reaches their values. Data larger than the whole ring never fits and is rejected right away
+    if (size > kTransferBufferSize) {
+        return false;
+    }
+    size = align((gerium_uint32_t) size, 16);
+    while (true) {
+        offset       = _transferBufferOffset;
+        auto padding = size_t(0);
+        if (offset + size > kTransferBufferSize) {
+            padding = kTransferBufferSize - offset;
+            offset  = 0;
+        }
+        if (_transferBufferUsed + padding + size <= kTransferBufferSize) {
+            auto batch = beginTransferBatch();
+            if (!batch) {
+                return false;
+            }
+            _transferBufferUsed += padding + size;
+            _transferBufferOffset = offset + size;
+            batch->size += padding + size;
+            return true;
+        }
+        if (_transferBatch && !_transferBatch->requests.empty()) {
+            submitTransferBatch();
+        }
+        if (!retireTransferBatch(std::numeric_limits<gerium_uint64_t>::max())) {
+            return false;
+        }
+    }
+}
+
+VkRenderer::TransferBatch* VkRenderer::beginTransferBatch() {
+    if (!_transferBatch) {
+        // The oldest slot is reused only once it has retired, its command buffer and staging range may still be
+        // in use by the transfer queue otherwise
+        if (_transferBatchCount == kMaxTransferBatches &&
+            !retireTransferBatch(std::numeric_limits<gerium_uint64_t>::max())) {
+            return nullptr;
+        }
+        _transferBatch = &_transferBatches[(_transferBatchFirst + _transferBatchCount) % kMaxTransferBatches];
+        _transferBatch->commandBuffer = _transferCommandPool.getPrimary(0, false);
+    }
+    return _transferBatch;
+}
+
+void VkRenderer::submitTransferBatch() {
+    if (auto profiler = _device->profiler()) {
+        profiler->traceInstant("transfer_submit");
+    }
+    _transferBatch->timelineValue = ++_transferTimelineValue;
+    _transferBatch->commandBuffer->submit(
+        QueueType::CopyTransfer, false, _transferTimeline, _transferBatch->timelineValue);
+    _transferBatch = nullptr;
+    ++_transferBatchCount;
+}
+
+bool VkRenderer::retireTransferBatch(gerium_uint64_t timeout) {
+    if (!_transferBatchCount) {
+        return false;
+    }
+
+    auto& batch = _transferBatches[_transferBatchFirst];
+
+    VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &_transferTimeline;
+    waitInfo.pValues        = &batch.timelineValue;
+    if (_device->vkTable().vkWaitSemaphores(_device->vkDevice(), &waitInfo, timeout) != VK_SUCCESS) {
+        return false;
+    }
+
+    {
+        marl::lock lock(_transferToGraphicMutex);
+        for (const auto& request : batch.requests) {
+            _transferToGraphic.push(request);
+        }
+    }
+    batch.requests.clear();
 
-            gerium_texture_info_t info;
-            onGetTextureInfo(request.texture, info);
+    _transferBufferUsed -= batch.size;
+    batch.size = 0;
+    if (!_transferBufferUsed && !_transferBatch) {
+        _transferBufferOffset = 0;
+    }
 
-            const auto blockSize        = vk::blockSize((vk::Format) toVkFormat(info.format));
-            const auto alignedImageSize = align(info.width * info.height * blockSize, 4);
+    _transferBatchFirst = (_transferBatchFirst + 1) % kMaxTransferBatches;
+    --_transferBatchCount;
+    return true;
+}
+
+void VkRenderer::sendTextureToGraphic() {
+    CommandBuffer* commandBuffer = nullptr;
 
-            auto data = onMapBuffer(_transferBuffer, 0, alignedImageSize);
-            memcpy((void*) data, request.data, alignedImageSize);
-            onUnmapBuffer(_transferBuffer);
+    if (!_isSupportedTransferQueue) {
+        // Without a dedicated transfer queue, uploads are recorded into the frame itself and limited by the
+        // per-frame budget. Each frame in flight owns its slice of the staging buffer, which is free again once
+        // newFrame has waited for that frame.
+        const auto& budget     = options();
+        const auto sliceStride = kTransferBufferSize / _device->framesInFlight();
+        const auto sliceSize   = std::min<size_t>(budget.upload_budget_bytes, sliceStride);
+        const auto sliceOffset = _device->currentFrame() * sliceStride;
+
+        size_t size      = 0;
+        size_t sliceUsed = 0;
+        _frameRequests.clear();
+        {
+            marl::lock lock(_loadRequestsMutex);
+            while (!_loadRequests.empty() && _frameRequests.size() < budget.upload_budget_copies) {
+                const auto& request = _loadRequests.front();
+                const auto dataSize = align(request.dataSize, 16);
+                const auto useSlice = request.buffer == Undefined;
+                if (!_frameRequests.empty() &&
+                    (size + dataSize > budget.upload_budget_bytes || (useSlice && sliceUsed + dataSize > sliceSize))) {
+                    break;
+                }
+                size += dataSize;
+                sliceUsed += useSlice ? dataSize : 0;
+                _frameRequests.push_back(request);
+                _loadRequests.pop();
+            }
+        }
 
-            auto commandBuffer = _transferCommandPool.getPrimary(0, false);
-            commandBuffer->copyBuffer(_transferBuffer, request.texture, request.mip);
-            commandBuffer->submit(QueueType::CopyTransfer);
+        size_t offset = sliceOffset;
+        _textureCopies.clear();
+        for (auto& request : _frameRequests) {
+            if (request.result != GERIUM_RESULT_SUCCESS) {
+                // A failed load, only its callback is left to call
+            } else if (request.buffer == Undefined && align(request.dataSize, 16) > sliceStride) {
+                // The first request of a frame is taken whatever its size, but it still has to fit into the slice
+                request.result = GERIUM_RESULT_ERROR_OUT_OF_MEMORY;
+            } else if (request.buffer != Undefined) {
+                _textureCopies.push_back({ request.buffer, request.texture, request.mip, request.bufferOffset });
+            } else {
+                auto data = onMapBuffer(_transferBuffer, (gerium_uint32_t) offset, request.dataSize);
+                memcpy((void*) data, request.data, request.dataSize);
+                onUnmapBuffer(_transferBuffer);
 
+                _textureCopies.push_back({ _transferBuffer, request.texture, request.mip, (gerium_uint32_t) offset });
+                offset += align(request.dataSize, 16);
+            }
             _transferToGraphic.push(request);
         }
+
+        if (!_textureCopies.empty()) {
+            commandBuffer = _device->getPrimaryCommandBuffer(false);
+            commandBuffer->copyBuffer((gerium_uint32_t) _textureCopies.size(), _textureCopies.data());
+        }
     }
 
     if (_isSupportedTransferQueue) {
         _transferToGraphicMutex.lock();
     }
     defer(if (_isSupportedTransferQueue) _transferToGraphicMutex.unlock());
+
+    _frameUploads     = 0;
+    _frameUploadBytes = 0;
+
     if (!_transferToGraphic.empty()) {
-        auto commandBuffer = _device->getPrimaryCommandBuffer(false);
+        if (!commandBuffer) {
+            commandBuffer = _device->getPrimaryCommandBuffer(false);
+        }
+        _textureCopies.clear();
         while (!_transferToGraphic.empty()) {
             const auto& request = _transferToGraphic.front();
-            if (request.generateMips) {
-                commandBuffer->generateMipmaps(request.texture);
-                _device->finishLoadTexture(request.texture, 0);
-            } else {
-                commandBuffer->addImageBarrier(request.texture, ResourceState::ShaderResource, request.mip, 1);
-                _device->finishLoadTexture(request.texture, request.mip);
-                _device->showViewMips(request.texture, request.mip);
+            // A failed request copied nothing and is only reported back through its callback
+            if (request.result == GERIUM_RESULT_SUCCESS) {
+                if (request.generateMips) {
+                    commandBuffer->generateMipmaps(request.texture);
+                    _device->finishLoadTexture(request.texture, 0);
+                } else {
+                    _textureCopies.push_back({ Undefined, request.texture, request.mip, 0 });
+                }
+                ++_frameUploads;
+                _frameUploadBytes += request.dataSize;
             }
+            --_pendingUploads;
+            _pendingUploadBytes -= request.dataSize;
             _finishedRequests.push(request);
             _transferToGraphic.pop();
         }
+
+        commandBuffer->addImageBarriers(
+            (gerium_uint32_t) _textureCopies.size(), _textureCopies.data(), ResourceState::ShaderResource);
+        for (const auto& copy : _textureCopies) {
+            _device->finishLoadTexture(copy.texture, copy.mip);
+            _device->showViewMips(copy.texture, copy.mip);
+        }
         _device->submit(commandBuffer);
     }
 }
@@ -377,18 +554,89 @@ void VkRenderer::onAsyncUploadTextureData(TextureHandle handle,
                                           bool generateMips,
                                           gerium_uint32_t textureDataSize,
                                           gerium_cdata_t textureData,
+                                          BufferHandle stagingBuffer,
+                                          gerium_uint32_t stagingOffset,
                                           gerium_texture_loaded_func_t callback,
                                           gerium_data_t data) {
-    const auto request = LoadRequest{ textureDataSize, textureData, mip, generateMips, handle, callback, data };
+    if (!textureDataSize) {
+        gerium_texture_info_t info;
+        onGetTextureInfo(handle, info);
+
+        const auto blockSize = vk::blockSize((vk::Format) toVkFormat(info.format));
+        textureDataSize      = align(info.width * info.height * blockSize, 4);
+    }
+
+    const auto request = LoadRequest{
+        textureDataSize, textureData, stagingBuffer, stagingOffset, mip, generateMips, handle, callback, data
+    };
+    ++_pendingUploads;
+    _pendingUploadBytes += textureDataSize;
+
+    marl::lock lock(_loadRequestsMutex);
+    _loadRequests.push(request);
     if (_isSupportedTransferQueue) {
-        marl::lock lock(_loadRequestsMutex);
-        _loadRequests.push(request);
         _loadEvent.signal();
-    } else {
-        _loadRequests.push(request);
     }
 }
 
+void VkRenderer::onCompleteLoad(TextureHandle handle,
+                                gerium_result_t result,
+                                gerium_texture_loaded_func_t callback,
+                                gerium_data_t data) {
+    // Nothing to copy: the request only passes through the upload queues so that its callback is called from
+    // onPresent like the callbacks of finished uploads. A failed result is what marks it as such, a cancelled
+    // load is reported as failed too (its callback does not reach the user)
+    auto request     = LoadRequest{};
+    request.texture  = handle;
+    request.callback = callback;
+    request.userData = data;
+    request.result   = result == GERIUM_RESULT_SUCCESS ? GERIUM_RESULT_ERROR_LOAD_TEXTURE : result;
+    ++_pendingUploads;
+
+    marl::lock lock(_loadRequestsMutex);
+    _loadRequests.push(request);
+    if (_isSupportedTransferQueue) {
+        _loadEvent.signal();
+    }
+}
+
+void VkRenderer::onGetUploadStats(gerium_upload_stats_t& stats) const noexcept {
+    stats.pending_uploads      = _pendingUploads;
+    stats.pending_upload_bytes = _pendingUploadBytes;
+    stats.frame_uploads        = _frameUploads;
+    stats.frame_upload_bytes   = _frameUploadBytes;
+}
+
+void VkRenderer::onCopyTextureMips(gerium_uint32_t count, const TextureMipCopy* copies) {
+    auto commandBuffer = _device->getPrimaryCommandBuffer(false);
+    for (gerium_uint32_t i = 0; i < count; ++i) {
+        const auto& copy = copies[i];
+        commandBuffer->copyTexture(copy.src, copy.srcMip, copy.dst, copy.dstMip, copy.mipCount);
+        _device->finishLoadTexture(copy.dst, copy.dstMip, true);
+    }
+    _device->submit(commandBuffer);
+}
+
+void VkRenderer::onSwapTextures(TextureHandle lhs, TextureHandle rhs) noexcept {
+    _device->swapTextures(lhs, rhs);
+}
+
+void VkRenderer::onGetMemoryBudget(gerium_uint64_t& budget, gerium_uint64_t& usage) noexcept {
+    _device->getMemoryBudget(budget, usage);
+}
+
+gerium_uint64_t VkRenderer::onGetTextureMemory(TextureHandle handle) const noexcept {
+    return _device->getTextureMemory(handle);
+}
+
+void VkRenderer::onGetEvictionCandidates(gerium_uint32_t minIdleFrames, std::vector<gerium_eviction_t>& candidates) {
+    _device->getEvictionCandidates(minIdleFrames, candidates);
+}
+
+bool VkRenderer::onDemoteBuffer(BufferHandle handle) {
+    return _device->demoteBuffer(handle);
+}
+
 void VkRenderer::onTextureSampler(TextureHandle handle,
                                   gerium_filter_t minFilter,
                                   gerium_filter_t magFilter,
@@ -493,44 +741,67 @@ bool VkRenderer::onNewFrame() {
 
 void VkRenderer::onRender(FrameGraph& frameGraph) {
     const auto maxWorkers = _application->workerThreadCount();
+    const auto profiler   = _device->profiler();
+
+    ProfilerScope renderScope(profiler, "render");
 
     gerium_uint16_t width, height;
     getSwapchainSize(width, height);
 
     if (_width != width || _height != height) {
         if (_width != 0 && _height != 0) {
+            ProfilerEvent resizeEvent(profiler, GERIUM_HITCH_CAUSE_FRAME_GRAPH_RESIZE, "frame_graph");
             frameGraph.resize(_width, width, _height, height);
         }
         _width  = width;
         _height = height;
     }
-    frameGraph.compile();
 
-    gerium_uint32_t allTotalWorkers[kMaxNodes];
-    for (gerium_uint32_t i = 0, worker = 0; i < frameGraph.nodeCount(); ++i) {
-        auto node = frameGraph.getNode(i);
+    {
+        ProfilerScope compileScope(profiler, "frame_graph_compile");
+        ProfilerEvent compileEvent(
+            frameGraph.hasChanges() ? profiler : nullptr, GERIUM_HITCH_CAUSE_FRAME_GRAPH_COMPILE, "frame_graph");
+        frameGraph.compile();
+    }
 
-        if (!node->enabled) {
-            continue;
-        }
+    gerium_uint32_t allTotalWorkers[kMaxNodes];
+    {
+        ProfilerScope prepareScope(profiler, "prepare");
+        for (gerium_uint32_t i = 0, worker = 0; i < frameGraph.nodeCount(); ++i) {
+            auto node = frameGraph.getNode(i);
 
-        allTotalWorkers[worker] = 1;
-        if (auto pass = frameGraph.getPass(node->pass); pass->pass.prepare) {
-            allTotalWorkers[worker] = std::clamp(
-                pass->pass.prepare(alias_cast<gerium_frame_graph_t>(&frameGraph), this, maxWorkers, pass->data),
-                (gerium_uint32_t) 1,
-                maxWorkers);
-            if (allTotalWorkers[worker] == 0) {
-                error(GERIUM_RESULT_ERROR_FROM_CALLBACK);
+            if (!node->enabled) {
+                continue;
+            }
+            ProfilerScope nodeScope(profiler, node->name);
+
+            allTotalWorkers[worker] = 1;
+            if (auto pass = frameGraph.getPass(node->pass); pass->pass.prepare) {
+                allTotalWorkers[worker] = std::clamp(
+                    pass->pass.prepare(alias_cast<gerium_frame_graph_t>(&frameGraph), this, maxWorkers, pass->data),
+                    (gerium_uint32_t) 1,
+                    maxWorkers);
+                if (allTotalWorkers[worker] == 0) {
+                    error(GERIUM_RESULT_ERROR_FROM_CALLBACK);
+                }
             }
+            ++worker;
         }
-        ++worker;
     }
 
     CommandBuffer* secondaryCommandBuffers[100];
     gerium_uint32_t numSecondaryCommandBuffers = 0;
 
-    std::set<TextureHandle> depths;
+    // Per frame state lives in members that keep their capacity, the recording loop does not allocate
+    _depths.clear();
+    const auto addDepth = [this](TextureHandle texture) {
+        if (std::find(_depths.cbegin(), _depths.cend(), texture) == _depths.cend()) {
+            _depths.push_back(texture);
+        }
+    };
+    if (_renderTasks.size() < maxWorkers) {
+        _renderTasks.resize(maxWorkers);
+    }
 
     auto cb = _device->getPrimaryCommandBuffer();
     cb->bindRenderer(this);
@@ -544,6 +815,13 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
         }
         _currentRenderPassName = node->name;
 
+        ProfilerScope nodeScope(profiler, node->name);
+
+        const auto counterNode = totalWorkerIndex + 1;
+        if (profiler) {
+            profiler->setCounterNode(counterNode, node->name);
+        }
+
         cb->pushLabel(node->name);
         cb->pushMarker(node->name);
 
@@ -569,7 +847,7 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
 
                 if (hasDepthOrStencil(format)) {
                     cb->addImageBarrier(texture, ResourceState::DepthRead, 0, 1);
-                    depths.insert(texture);
+                    addDepth(texture);
                 } else {
                     cb->addImageBarrier(texture, ResourceState::ShaderResource, 0, 1);
                 }
@@ -588,7 +866,7 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
                 if (hasDepthOrStencil(format)) {
                     cb->addImageBarrier(
                         texture, !node->compute ? ResourceState::DepthWrite : ResourceState::UnorderedAccess, 0, 1);
-                    depths.insert(texture);
+                    addDepth(texture);
                 } else {
                     cb->addImageBarrier(
                         texture, !node->compute ? ResourceState::RenderTarget : ResourceState::UnorderedAccess, 0, 1);
@@ -620,7 +898,7 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
                 if (hasDepthOrStencil(format)) {
                     cb->addImageBarrier(
                         texture, !node->compute ? ResourceState::DepthWrite : ResourceState::UnorderedAccess, 0, 1);
-                    depths.insert(texture);
+                    addDepth(texture);
                     if (!node->compute) {
                         cb->clearDepthStencil(resource->info.texture.clearDepthStencil.depth,
                                               resource->info.texture.clearDepthStencil.value);
@@ -652,6 +930,11 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
         auto framebuffer  = node->framebuffers[framebufferIndex];
         auto useWorkers   = totalWorkers != 1;
 
+        // Work recorded on secondary command buffers is only counted when they can inherit the query
+        if (!useWorkers || _device->inheritedQueriesSupported()) {
+            cb->beginStatistics(node->name);
+        }
+
         if (!node->outputCount) {
             width       = _device->getSwapchainExtent().width;
             height      = _device->getSwapchainExtent().height;
@@ -666,7 +949,7 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
             cb->setScissor(0, 0, width, height);
             cb->bindPass(renderPass, framebuffer, useWorkers);
             if (useWorkers) {
-                marl::WaitGroup waitAll(totalWorkers);
+                _renderWorkers.add(totalWorkers);
                 numSecondaryCommandBuffers = 0;
                 for (gerium_uint32_t worker = 0; worker < totalWorkers; ++worker) {
                     auto secondary = _device->getSecondaryCommandBuffer(worker, renderPass, framebuffer);
@@ -677,24 +960,19 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
                     secondary->setFrameGraph(&frameGraph);
                     secondaryCommandBuffers[numSecondaryCommandBuffers++] = secondary;
 
-                    marl::schedule([waitAll, worker, totalWorkers, cb = secondary, pass, renderer = this, &frameGraph] {
-                        defer(waitAll.done());
-
-                        if (!pass->pass.render(alias_cast<gerium_frame_graph_t>(&frameGraph),
-                                               renderer,
-                                               cb,
-                                               worker,
-                                               totalWorkers,
-                                               pass->data)) {
-                            error(GERIUM_RESULT_ERROR_FROM_CALLBACK);
-                        }
+                    // The task only captures two pointers, which std::function stores without allocating
+                    auto task = &_renderTasks[worker];
+                    *task     = { &frameGraph, pass, secondary, node->name, counterNode, worker, totalWorkers };
+                    marl::schedule([renderer = this, task] {
+                        renderer->renderWorker(*task);
                     });
                 }
 
-                waitAll.wait();
+                _renderWorkers.wait();
 
                 cb->execute(numSecondaryCommandBuffers, secondaryCommandBuffers);
             } else {
+                AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_COMMAND_BUFFER);
                 if (!pass->pass.render(alias_cast<gerium_frame_graph_t>(&frameGraph), this, cb, 0, 1, pass->data)) {
                     error(GERIUM_RESULT_ERROR_FROM_CALLBACK);
                 }
@@ -723,19 +1001,22 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
 
             cb->endCurrentRenderPass();
         } else {
+            AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_COMMAND_BUFFER);
             if (!pass->pass.render(alias_cast<gerium_frame_graph_t>(&frameGraph), this, cb, 0, 1, pass->data)) {
                 error(GERIUM_RESULT_ERROR_FROM_CALLBACK);
             }
         }
 
+        cb->endStatistics();
         cb->popMarker();
         cb->popLabel();
+        cb->flushCounters(counterNode);
 
         ++totalWorkerIndex;
     }
     cb->popMarker();
 
-    for (auto depth : depths) {
+    for (auto depth : _depths) {
         cb->addImageBarrier(depth, ResourceState::DepthRead, 0, 1);
     }
 
@@ -743,13 +1024,33 @@ void VkRenderer::onRender(FrameGraph& frameGraph) {
     _device->submit(cb);
 }
 
+void VkRenderer::renderWorker(const RenderTask& task) {
+    defer(_renderWorkers.done());
+
+    AllocationScope allocationScope(GERIUM_ALLOCATION_SCOPE_COMMAND_BUFFER);
+
+    const auto profiler = _device->profiler();
+    ProfilerScope workerScope(profiler, "render_worker");
+    ProfilerScope nodeScope(profiler, task.name);
+
+    if (!task.pass->pass.render(alias_cast<gerium_frame_graph_t>(task.frameGraph),
+                                this,
+                                task.commandBuffer,
+                                task.worker,
+                                task.totalWorkers,
+                                task.pass->data)) {
+        error(GERIUM_RESULT_ERROR_FROM_CALLBACK);
+    }
+    task.commandBuffer->flushCounters(task.counterNode);
+}
+
 void VkRenderer::onPresent() {
     _device->present();
 
     while (!_finishedRequests.empty()) {
         const auto& request = _finishedRequests.front();
         if (request.callback) {
-            request.callback(this, request.texture, request.userData);
+            request.callback(this, request.texture, request.result, request.userData);
         }
         _finishedRequests.pop();
     }
@@ -789,56 +1090,87 @@ void VkRenderer::onGetSwapchainSize(gerium_uint16_t& width, gerium_uint16_t& hei
 }
 
 void VkRenderer::loadThread() noexcept {
-    LoadRequest request;
-    std::vector<LoadRequest> tasks;
+    constexpr gerium_uint64_t kPollTimeout = 1000000; // 1 ms
 
-    auto finishLoad = [this, &tasks]() {
-        marl::lock lock(_transferToGraphicMutex);
-        for (auto& task : tasks) {
-            _transferToGraphic.push(task);
-        }
-        tasks.clear();
-    };
+    std::vector<LoadRequest> requests;
 
     while (!_loadThreadEnd.test()) {
-        _loadEvent.wait();
         {
             marl::lock lock(_loadRequestsMutex);
-            if (_loadRequests.empty()) {
+            while (!_loadRequests.empty()) {
+                requests.push_back(_loadRequests.front());
+                _loadRequests.pop();
+            }
+            if (requests.empty() && !_transferBatchCount) {
                 _loadEvent.clear();
-                _transferCommandPool.wait(QueueType::CopyTransfer);
-                _transferBufferOffset = 0;
-                finishLoad();
-                continue;
             }
-            request = _loadRequests.front();
-            _loadRequests.pop();
+        }
 
-            tasks.push_back(request);
+        if (requests.empty()) {
+            if (_transferBatchCount) {
+                retireTransferBatch(kPollTimeout);
+            } else {
+                _loadEvent.wait();
+            }
+            continue;
         }
 
-        gerium_texture_info_t info;
-        onGetTextureInfo(request.texture, info);
+        ProfilerScope scope(_device->profiler(), "upload_textures");
 
-        const auto blockSize = vk::blockSize((vk::Format) toVkFormat(info.format));
-        const auto alignedImageSize =
-            request.dataSize ? request.dataSize : align(info.width * info.height * blockSize, 4);
-        const auto currentOffset = _transferBufferOffset;
-        _transferBufferOffset += alignedImageSize;
+        // All pending requests are recorded into as few command buffers as possible, every copy gets its own
+        // region in the staging ring
+        for (const auto& request : requests) {
+            if (request.result != GERIUM_RESULT_SUCCESS) {
+                marl::lock lock(_transferToGraphicMutex);
+                _transferToGraphic.push(request);
+                continue;
+            }
+            if (request.buffer != Undefined) {
+                // The data was decoded straight into a staging buffer, nothing to copy on the CPU
+                auto batch = beginTransferBatch();
+                if (!batch) {
+                    auto failed   = request;
+                    failed.result = GERIUM_RESULT_ERROR_DEVICE_LOST;
+                    marl::lock lock(_transferToGraphicMutex);
+                    _transferToGraphic.push(failed);
+                    continue;
+                }
+                batch->commandBuffer->copyBuffer(request.buffer, request.texture, request.mip, request.bufferOffset);
+            } else {
+                size_t offset;
+                if (!allocateTransferData(request.dataSize, offset)) {
+                    // Throwing here would terminate the upload thread, the request is reported back as failed
+                    auto failed   = request;
+                    failed.result = GERIUM_RESULT_ERROR_OUT_OF_MEMORY;
+                    marl::lock lock(_transferToGraphicMutex);
+                    _transferToGraphic.push(failed);
+                    continue;
+                }
 
-        auto data = onMapBuffer(_transferBuffer, (gerium_uint32_t) currentOffset, alignedImageSize);
-        memcpy((void*) data, request.data, alignedImageSize);
-        onUnmapBuffer(_transferBuffer);
+                auto data = onMapBuffer(_transferBuffer, (gerium_uint32_t) offset, request.dataSize);
+                memcpy((void*) data, request.data, request.dataSize);
+                onUnmapBuffer(_transferBuffer);
 
-        auto commandBuffer = _transferCommandPool.getPrimary(0, false);
-        commandBuffer->copyBuffer(_transferBuffer, request.texture, request.mip, (gerium_uint32_t) currentOffset);
-        commandBuffer->submit(QueueType::CopyTransfer, false);
+                _transferBatch->commandBuffer->copyBuffer(
+                    _transferBuffer, request.texture, request.mip, (gerium_uint32_t) offset);
+            }
+            _transferBatch->requests.push_back(request);
+
+            if (_transferBatch->requests.size() >= _transferMaxTasks) {
+                submitTransferBatch();
+            }
+        }
+        requests.clear();
 
-        if (tasks.size() >= _transferMaxTasks) {
-            _transferCommandPool.wait(QueueType::CopyTransfer);
-            _transferBufferOffset = 0;
-            finishLoad();
+        if (_transferBatch && !_transferBatch->requests.empty()) {
+            submitTransferBatch();
         }
+
+        while (retireTransferBatch(0)) {
+        }
+    }
+
+    while (retireTransferBatch(std::numeric_limits<gerium_uint64_t>::max())) {
     }
 }
 
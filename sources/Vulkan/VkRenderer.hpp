@@ -25,16 +25,45 @@ private:
     struct LoadRequest {
         gerium_uint32_t dataSize{};
         gerium_cdata_t data{};
+        BufferHandle buffer{ Undefined };
+        gerium_uint32_t bufferOffset{};
         gerium_uint8_t mip{};
         bool generateMips{};
         TextureHandle texture{ Undefined };
         gerium_texture_loaded_func_t callback{};
         gerium_data_t userData{};
+        gerium_result_t result{ GERIUM_RESULT_SUCCESS };
     };
 
+    struct TransferBatch {
+        CommandBuffer* commandBuffer{};
+        gerium_uint64_t timelineValue{};
+        size_t size{};
+        std::vector<LoadRequest> requests;
+    };
+
+    struct RenderTask {
+        FrameGraph* frameGraph{};
+        const FrameGraphRenderPass* pass{};
+        CommandBuffer* commandBuffer{};
+        gerium_utf8_t name{};
+        gerium_uint32_t counterNode{};
+        gerium_uint32_t worker{};
+        gerium_uint32_t totalWorkers{};
+    };
+
+    static constexpr size_t kTransferBufferSize          = 256 * 1024 * 1024;
+    static constexpr gerium_uint32_t kMaxTransferBatches = 4;
+
     void createTransferBuffer();
+    void destroyTransferBatches() noexcept;
+    bool allocateTransferData(size_t size, size_t& offset);
+    TransferBatch* beginTransferBatch();
+    void submitTransferBatch();
+    bool retireTransferBatch(gerium_uint64_t timeout);
     void sendTextureToGraphic();
     bool isResourceEnabled(FrameGraph& frameGraph, const FrameGraphResource* resource) const noexcept;
+    void renderWorker(const RenderTask& task);
 
     gerium_feature_flags_t onGetEnabledFeatures() const noexcept override;
     TextureCompressionFlags onGetTextureComperssion() const noexcept override;
@@ -63,8 +92,22 @@ private:
                                   bool generateMips,
                                   gerium_uint32_t textureDataSize,
                                   gerium_cdata_t textureData,
+                                  BufferHandle stagingBuffer,
+                                  gerium_uint32_t stagingOffset,
                                   gerium_texture_loaded_func_t callback,
                                   gerium_data_t data) override;
+    void onCompleteLoad(TextureHandle handle,
+                        gerium_result_t result,
+                        gerium_texture_loaded_func_t callback,
+                        gerium_data_t data) override;
+
+    void onGetUploadStats(gerium_upload_stats_t& stats) const noexcept override;
+    void onCopyTextureMips(gerium_uint32_t count, const TextureMipCopy* copies) override;
+    void onSwapTextures(TextureHandle lhs, TextureHandle rhs) noexcept override;
+    void onGetMemoryBudget(gerium_uint64_t& budget, gerium_uint64_t& usage) noexcept override;
+    gerium_uint64_t onGetTextureMemory(TextureHandle handle) const noexcept override;
+    void onGetEvictionCandidates(gerium_uint32_t minIdleFrames, std::vector<gerium_eviction_t>& candidates) override;
+    bool onDemoteBuffer(BufferHandle handle) override;
 
     void onTextureSampler(TextureHandle handle,
                           gerium_filter_t minFilter,
@@ -123,6 +166,13 @@ private:
     gerium_uint32_t _transferMaxTasks;
     BufferHandle _transferBuffer;
     size_t _transferBufferOffset;
+    size_t _transferBufferUsed;
+    TransferBatch _transferBatches[kMaxTransferBatches];
+    TransferBatch* _transferBatch;
+    VkSemaphore _transferTimeline;
+    gerium_uint64_t _transferTimelineValue;
+    gerium_uint32_t _transferBatchFirst;
+    gerium_uint32_t _transferBatchCount;
     CommandBufferPool _transferCommandPool;
     std::thread _loadTread;
     marl::Event _loadEvent;
@@ -132,8 +182,17 @@ private:
     std::queue<LoadRequest> _loadRequests;
     std::queue<LoadRequest> _transferToGraphic;
     std::queue<LoadRequest> _finishedRequests;
+    std::vector<LoadRequest> _frameRequests;
+    std::vector<TextureCopy> _textureCopies;
+    std::atomic<gerium_uint32_t> _pendingUploads;
+    std::atomic<gerium_uint64_t> _pendingUploadBytes;
+    gerium_uint32_t _frameUploads;
+    gerium_uint64_t _frameUploadBytes;
     gerium_uint32_t _prevFrame;
     gerium_uint32_t _frame;
+    std::vector<TextureHandle> _depths;
+    std::vector<RenderTask> _renderTasks;
+    marl::WaitGroup _renderWorkers;
 };
 
 } // namespace gerium::vulkan
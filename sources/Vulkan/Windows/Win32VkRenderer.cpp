@@ -16,6 +16,7 @@ gerium_result_t gerium_renderer_create(gerium_application_t application,
                                        gerium_feature_flags_t features,
                                        gerium_uint32_t version,
                                        gerium_bool_t debug,
+                                       const gerium_renderer_options_t* options,
                                        gerium_renderer_t* renderer) {
     using namespace gerium;
     using namespace gerium::windows;
@@ -26,6 +27,6 @@ gerium_result_t gerium_renderer_create(gerium_application_t application,
         return result;
     }
     GERIUM_BEGIN_SAFE_BLOCK
-        alias_cast<Win32VkRenderer*>(*renderer)->initialize(features, version, debug != 0);
+        alias_cast<Win32VkRenderer*>(*renderer)->initialize(features, version, debug != 0, options);
     GERIUM_END_SAFE_BLOCK
 }
@@ -1,4 +1,5 @@
 #include "Win32File.hpp"
+#include "../Archive.hpp"
 #include "Unicode.hpp"
 
 #include <Psapi.h>
@@ -124,6 +125,20 @@ gerium_uint32_t Win32File::onRead(gerium_data_t data, gerium_uint32_t size) noex
     return gerium_uint32_t(writen);
 }
 
+gerium_uint32_t Win32File::onReadAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) {
+    OVERLAPPED overlapped{};
+    overlapped.Offset     = (DWORD) (offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = (DWORD) (offset >> 32);
+
+    DWORD readed = 0;
+    if (!ReadFile(_file, (LPVOID) data, (DWORD) size, &readed, &overlapped)) {
+        if (GetLastError() != ERROR_HANDLE_EOF) {
+            error(GERIUM_RESULT_ERROR_FILE_READ);
+        }
+    }
+    return gerium_uint32_t(readed);
+}
+
 gerium_data_t Win32File::onMap() noexcept {
     if (!_data) {
         _map = CreateFileMappingW(_file, NULL, isReadOnly() ? PAGE_READONLY : PAGE_READWRITE, 0, 0, nullptr);
@@ -195,6 +210,9 @@ gerium_utf8_t File::getAppDir() noexcept {
 }
 
 bool File::existsFile(gerium_utf8_t path) noexcept {
+    if (Archive::exists(path)) {
+        return true;
+    }
     const auto file  = gerium::windows::wideString(path);
     const auto attrs = GetFileAttributesW(file.c_str());
     return attrs != INVALID_FILE_ATTRIBUTES && (attrs & FILE_ATTRIBUTE_DIRECTORY) != FILE_ATTRIBUTE_DIRECTORY;
@@ -216,6 +234,11 @@ void File::deleteFile(gerium_utf8_t path) noexcept {
 gerium_result_t gerium_file_open(gerium_utf8_t path, gerium_bool_t read_only, gerium_file_t* file) {
     using namespace gerium;
     using namespace gerium::windows;
+    if (read_only) {
+        if (auto result = Archive::open(path, file); result != GERIUM_RESULT_ERROR_NOT_FOUND) {
+            return result;
+        }
+    }
     return Object::create<Win32File>(*file, path, read_only != 0);
 }
 
@@ -21,6 +21,7 @@ private:
     void onWrite(gerium_cdata_t data, gerium_uint32_t size) override;
     gerium_uint32_t onRead(gerium_data_t data, gerium_uint32_t size) noexcept override;
     gerium_data_t onMap() noexcept override;
+    gerium_uint32_t onReadAt(gerium_uint64_t offset, gerium_data_t data, gerium_uint32_t size) override;
 
     static std::string getTempFileName();
 
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+#include <wyhash.h>
+#include <zstd.h>
+
+#include "../../sources/ArchiveFormat.hpp"
+
+using namespace gerium;
+
+struct Item {
+    std::filesystem::path path;
+    std::string name;
+    archive::Entry entry;
+};
+
+static uint64_t alignOffset(uint64_t offset, uint64_t alignment) {
+    return alignment ? (offset + alignment - 1) / alignment * alignment : offset;
+}
+
+static void writePadding(std::ofstream& stream, uint64_t offset) {
+    static const char zeros[4096]{};
+    auto position = uint64_t(stream.tellp());
+    while (position < offset) {
+        auto count = std::min<uint64_t>(offset - position, sizeof(zeros));
+        stream.write(zeros, std::streamsize(count));
+        position += count;
+    }
+}
+
+static std::vector<char> readFile(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (stream.fail()) {
+        throw std::runtime_error("failed to open " + path.string());
+    }
+    std::vector<char> data(size_t(stream.tellg()));
+    stream.seekg(0);
+    stream.read(data.data(), std::streamsize(data.size()));
+    return data;
+}
+
+int main(int argc, char* argv[]) {
+    argparse::ArgumentParser program("archive-pack", "1.0.0");
+
+    std::string input;
+    std::string out;
+    bool compress    = false;
+    int level        = 19;
+    double minRatio  = 0.9;
+    size_t alignment = 16;
+    std::vector<std::string> skip;
+    program.add_argument("dir")
+        .help("directory to pack (paths in the archive are relative to it)")
+        .required()
+        .store_into(input);
+    program.add_argument("-o", "--out").help("out archive path").required().store_into(out);
+    program.add_argument("-c", "--compress").help("compress chunks with zstd").implicit_value(true).store_into(compress);
+    program.add_argument("-l", "--level").help("zstd compression level").store_into(level);
+    program.add_argument("-r", "--ratio")
+        .help("store a chunk compressed only if compressed/original size is below this ratio")
+        .store_into(minRatio);
+    program.add_argument("-a", "--alignment").help("alignment of data chunks in bytes").store_into(alignment);
+    program.add_argument("-s", "--skip").help("list of file extensions to skip").append().store_into(skip);
+
+    try {
+        program.parse_args(argc, argv);
+    } catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << program;
+        return EXIT_FAILURE;
+    }
+
+    if (alignment & (alignment - 1)) {
+        std::cerr << "alignment must be a power of two" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto root = std::filesystem::path(input).lexically_normal();
+
+    std::vector<Item> items;
+    for (const auto& file : std::filesystem::recursive_directory_iterator(root)) {
+        if (!file.is_regular_file()) {
+            continue;
+        }
+        const auto extension = file.path().extension().string();
+        if (std::find(skip.cbegin(), skip.cend(), extension) != skip.cend()) {
+            continue;
+        }
+
+        Item item{};
+        item.path       = file.path();
+        item.name       = file.path().lexically_relative(root).generic_string();
+        item.entry.hash = wyhash(item.name.data(), item.name.length(), archive::kHashSeed, _wyp);
+        items.push_back(std::move(item));
+    }
+
+    std::sort(items.begin(), items.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.entry.hash != rhs.entry.hash ? lhs.entry.hash < rhs.entry.hash : lhs.name < rhs.name;
+    });
+
+    const auto outPath = std::filesystem::path(out);
+    if (outPath.has_parent_path()) {
+        std::filesystem::create_directories(outPath.parent_path());
+    }
+
+    std::ofstream stream(outPath, std::ios::binary);
+    if (stream.fail()) {
+        std::cerr << "failed to create " << out << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    archive::Header header{};
+    memcpy(header.magic, archive::kMagic, sizeof(archive::kMagic));
+    header.version    = archive::kVersion;
+    header.entryCount = uint32_t(items.size());
+    header.alignment  = uint32_t(alignment);
+    stream.write((const char*) &header, sizeof(header));
+
+    std::string strings;
+    uint64_t totalSize  = 0;
+    uint64_t storedSize = 0;
+
+    try {
+        for (auto& item : items) {
+            auto data = readFile(item.path);
+
+            std::vector<char> compressed;
+            auto chunk = &data;
+            if (compress && !data.empty()) {
+                compressed.resize(ZSTD_compressBound(data.size()));
+                const auto size = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(), level);
+                if (ZSTD_isError(size)) {
+                    throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(size));
+                }
+                if (double(size) < double(data.size()) * minRatio) {
+                    compressed.resize(size);
+                    chunk                  = &compressed;
+                    item.entry.compression = archive::Compression::Zstd;
+                }
+            }
+
+            const auto offset = alignOffset(uint64_t(stream.tellp()), alignment);
+            writePadding(stream, offset);
+            stream.write(chunk->data(), std::streamsize(chunk->size()));
+
+            item.entry.offset     = offset;
+            item.entry.size       = data.size();
+            item.entry.storedSize = chunk->size();
+            item.entry.nameOffset = uint32_t(strings.length());
+            item.entry.nameLength = uint32_t(item.name.length());
+            strings += item.name;
+
+            totalSize += data.size();
+            storedSize += chunk->size();
+        }
+    } catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    header.entriesOffset = alignOffset(uint64_t(stream.tellp()), alignof(archive::Entry));
+    writePadding(stream, header.entriesOffset);
+    for (const auto& item : items) {
+        stream.write((const char*) &item.entry, sizeof(item.entry));
+    }
+
+    header.stringsOffset = uint64_t(stream.tellp());
+    header.stringsSize   = strings.length();
+    stream.write(strings.data(), std::streamsize(strings.length()));
+
+    stream.seekp(0);
+    stream.write((const char*) &header, sizeof(header));
+
+    if (stream.fail()) {
+        std::cerr << "failed to write " << out << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << items.size() << " files, " << totalSize << " bytes packed into " << storedSize << " bytes"
+              << std::endl;
+    return EXIT_SUCCESS;
+}